@@ -0,0 +1,225 @@
+#include "SurvivalActorRegistry.h"
+#include "SurvivalCharacter.h"
+#include "SurvivalBiomeManager.h"
+#include "Engine/World.h"
+
+namespace SurvivalActorRegistryConstants
+{
+    // About the size of a challenge or tether radius, so a proximity query covers a handful of cells
+    constexpr double CellSize = 1000.0;
+}
+
+USurvivalActorRegistry::USurvivalActorRegistry()
+{
+    CellSize = SurvivalActorRegistryConstants::CellSize;
+    InvCellSize = 1.0 / CellSize;
+}
+
+USurvivalActorRegistry* USurvivalActorRegistry::Get(const UObject* WorldContextObject)
+{
+    const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<USurvivalActorRegistry>() : nullptr;
+}
+
+bool USurvivalActorRegistry::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USurvivalActorRegistry::Deinitialize()
+{
+    Managers.Reset();
+    Entries.Reset();
+    EntryIndices.Reset();
+    Cells.Reset();
+
+    Super::Deinitialize();
+}
+
+TStatId USurvivalActorRegistry::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(USurvivalActorRegistry, STATGROUP_Tickables);
+}
+
+void USurvivalActorRegistry::RegisterManager(AActor* Manager)
+{
+    if (Manager)
+    {
+        Managers.AddUnique(Manager);
+    }
+}
+
+void USurvivalActorRegistry::UnregisterManager(AActor* Manager)
+{
+    Managers.Remove(Manager);
+}
+
+void USurvivalActorRegistry::RegisterCharacter(ASurvivalCharacter* Character)
+{
+    if (!Character || EntryIndices.Contains(Character))
+    {
+        return;
+    }
+
+    const int32 EntryIndex = Entries.Num();
+    FCharacterEntry& Entry = Entries.AddDefaulted_GetRef();
+    Entry.Character = Character;
+    Entry.Key = Character;
+    Entry.Location = Character->GetActorLocation();
+    Entry.Cell = GetCell(Entry.Location);
+
+    EntryIndices.Add(Character, EntryIndex);
+    AddToCell(Entry.Cell, EntryIndex);
+}
+
+void USurvivalActorRegistry::UnregisterCharacter(ASurvivalCharacter* Character)
+{
+    if (const int32* EntryIndex = EntryIndices.Find(Character))
+    {
+        RemoveEntry(*EntryIndex);
+    }
+}
+
+void USurvivalActorRegistry::Tick(float DeltaTime)
+{
+    // Backwards so a stale entry's swap-remove only pulls in entries already visited this tick
+    for (int32 EntryIndex = Entries.Num() - 1; EntryIndex >= 0; EntryIndex--)
+    {
+        FCharacterEntry& Entry = Entries[EntryIndex];
+        const ASurvivalCharacter* Character = Entry.Character.Get();
+        if (!Character)
+        {
+            RemoveEntry(EntryIndex);
+            continue;
+        }
+
+        Entry.Location = Character->GetActorLocation();
+
+        // Most ticks a character stays in its cell and the hash is left alone
+        const FIntPoint Cell = GetCell(Entry.Location);
+        if (Cell != Entry.Cell)
+        {
+            RemoveFromCell(Entry.Cell, EntryIndex);
+            AddToCell(Cell, EntryIndex);
+            Entry.Cell = Cell;
+        }
+    }
+}
+
+FIntPoint USurvivalActorRegistry::GetCell(const FVector& Location) const
+{
+    return FIntPoint(FMath::FloorToInt32(Location.X * InvCellSize), FMath::FloorToInt32(Location.Y * InvCellSize));
+}
+
+void USurvivalActorRegistry::AddToCell(const FIntPoint& Cell, int32 EntryIndex)
+{
+    Cells.FindOrAdd(Cell).Add(EntryIndex);
+}
+
+void USurvivalActorRegistry::RemoveFromCell(const FIntPoint& Cell, int32 EntryIndex)
+{
+    if (TArray<int32, TInlineAllocator<4>>* CellEntries = Cells.Find(Cell))
+    {
+        CellEntries->RemoveSingleSwap(EntryIndex);
+        if (CellEntries->Num() == 0)
+        {
+            Cells.Remove(Cell);
+        }
+    }
+}
+
+void USurvivalActorRegistry::RemoveEntry(int32 EntryIndex)
+{
+    RemoveFromCell(Entries[EntryIndex].Cell, EntryIndex);
+    EntryIndices.Remove(Entries[EntryIndex].Key);
+
+    // The last entry moves into the hole; its cell and map slot have to follow
+    const int32 LastIndex = Entries.Num() - 1;
+    if (EntryIndex != LastIndex)
+    {
+        const FCharacterEntry& Moved = Entries[LastIndex];
+        if (TArray<int32, TInlineAllocator<4>>* CellEntries = Cells.Find(Moved.Cell))
+        {
+            const int32 Slot = CellEntries->Find(LastIndex);
+            if (Slot != INDEX_NONE)
+            {
+                (*CellEntries)[Slot] = EntryIndex;
+            }
+        }
+        EntryIndices.Add(Moved.Key, EntryIndex);
+    }
+
+    Entries.RemoveAtSwap(EntryIndex);
+}
+
+void USurvivalActorRegistry::ForEachEntryInBox(const FVector2D& Min, const FVector2D& Max, TFunctionRef<void(const FCharacterEntry&)> Visit) const
+{
+    const FIntPoint MinCell(FMath::FloorToInt32(Min.X * InvCellSize), FMath::FloorToInt32(Min.Y * InvCellSize));
+    const FIntPoint MaxCell(FMath::FloorToInt32(Max.X * InvCellSize), FMath::FloorToInt32(Max.Y * InvCellSize));
+
+    // A box larger than the populated area would visit mostly empty cells; scan the entries instead
+    const int64 NumBoxCells = int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1);
+    if (NumBoxCells > Cells.Num())
+    {
+        for (const FCharacterEntry& Entry : Entries)
+        {
+            if (Entry.Cell.X >= MinCell.X && Entry.Cell.X <= MaxCell.X && Entry.Cell.Y >= MinCell.Y && Entry.Cell.Y <= MaxCell.Y)
+            {
+                Visit(Entry);
+            }
+        }
+        return;
+    }
+
+    for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; CellY++)
+    {
+        for (int32 CellX = MinCell.X; CellX <= MaxCell.X; CellX++)
+        {
+            if (const TArray<int32, TInlineAllocator<4>>* CellEntries = Cells.Find(FIntPoint(CellX, CellY)))
+            {
+                for (int32 EntryIndex : *CellEntries)
+                {
+                    Visit(Entries[EntryIndex]);
+                }
+            }
+        }
+    }
+}
+
+void USurvivalActorRegistry::GetCharactersInRadius(const FVector& Center, float Radius, TArray<ASurvivalCharacter*>& OutCharacters) const
+{
+    const double RadiusSq = double(Radius) * Radius;
+    ForEachEntryInBox(FVector2D(Center.X - Radius, Center.Y - Radius), FVector2D(Center.X + Radius, Center.Y + Radius), [&](const FCharacterEntry& Entry)
+    {
+        ASurvivalCharacter* Character = Entry.Character.Get();
+        if (Character && FVector::DistSquared(Entry.Location, Center) <= RadiusSq)
+        {
+            OutCharacters.Add(Character);
+        }
+    });
+}
+
+void USurvivalActorRegistry::GetCharactersInBiomeZone(const FBiomeZone& Zone, TArray<ASurvivalCharacter*>& OutCharacters) const
+{
+    const FVector2D Center(Zone.CenterLocation.X, Zone.CenterLocation.Y);
+    const double RadiusSq = double(Zone.Radius) * Zone.Radius;
+    ForEachEntryInBox(Center - Zone.Radius, Center + Zone.Radius, [&](const FCharacterEntry& Entry)
+    {
+        ASurvivalCharacter* Character = Entry.Character.Get();
+        if (Character && FVector2D::DistSquared(FVector2D(Entry.Location.X, Entry.Location.Y), Center) < RadiusSq)
+        {
+            OutCharacters.Add(Character);
+        }
+    });
+}
+
+void USurvivalActorRegistry::GetAllCharacters(TArray<ASurvivalCharacter*>& OutCharacters) const
+{
+    for (const FCharacterEntry& Entry : Entries)
+    {
+        if (ASurvivalCharacter* Character = Entry.Character.Get())
+        {
+            OutCharacters.Add(Character);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Kismet/GameplayStatics.h"
+#include "SurvivalActorRegistry.generated.h"
+
+class ASurvivalCharacter;
+struct FBiomeZone;
+
+// Survival characters and singleton managers of a game world. Managers register so others can find them
+// without an actor search; characters register into a uniform-grid spatial hash that follows them
+// incrementally (an entry only moves when its character changes cell), so proximity queries touch the few
+// cells in range instead of every actor.
+UCLASS()
+class RTS_API USurvivalActorRegistry : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    USurvivalActorRegistry();
+
+    // Null in worlds without one (editor and preview worlds); see FindManager
+    static USurvivalActorRegistry* Get(const UObject* WorldContextObject);
+
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Registered actors stay weakly referenced; unregister from EndPlay
+    void RegisterManager(AActor* Manager);
+    void UnregisterManager(AActor* Manager);
+
+    void RegisterCharacter(ASurvivalCharacter* Character);
+    void UnregisterCharacter(ASurvivalCharacter* Character);
+
+    // First registered manager of class T
+    template<typename T>
+    T* GetManager() const
+    {
+        for (const TWeakObjectPtr<AActor>& Manager : Managers)
+        {
+            if (T* Typed = Cast<T>(Manager.Get()))
+            {
+                return Typed;
+            }
+        }
+        return nullptr;
+    }
+
+    // The registry's manager when there is one, else an actor search (worlds without a registry, or a manager
+    // that doesn't register)
+    template<typename T>
+    static T* FindManager(const UObject* WorldContextObject)
+    {
+        if (USurvivalActorRegistry* Registry = Get(WorldContextObject))
+        {
+            if (T* Manager = Registry->GetManager<T>())
+            {
+                return Manager;
+            }
+        }
+        return Cast<T>(UGameplayStatics::GetActorOfClass(WorldContextObject, T::StaticClass()));
+    }
+
+    int32 GetNumCharacters() const { return Entries.Num(); }
+
+    // Characters within Radius of Center, by 3D distance to the locations of the last tick. Appends to OutCharacters.
+    void GetCharactersInRadius(const FVector& Center, float Radius, TArray<ASurvivalCharacter*>& OutCharacters) const;
+
+    // Characters whose location lies inside the zone's circle (XY only, like the zone's influence)
+    void GetCharactersInBiomeZone(const FBiomeZone& Zone, TArray<ASurvivalCharacter*>& OutCharacters) const;
+
+    void GetAllCharacters(TArray<ASurvivalCharacter*>& OutCharacters) const;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FCharacterEntry
+    {
+        TWeakObjectPtr<ASurvivalCharacter> Character;
+        // EntryIndices key, still usable once the character is gone
+        const ASurvivalCharacter* Key;
+        FVector Location;
+        FIntPoint Cell;
+    };
+
+    FIntPoint GetCell(const FVector& Location) const;
+    void AddToCell(const FIntPoint& Cell, int32 EntryIndex);
+    void RemoveFromCell(const FIntPoint& Cell, int32 EntryIndex);
+    void RemoveEntry(int32 EntryIndex);
+
+    // Visits every entry in the cells overlapping the XY box
+    void ForEachEntryInBox(const FVector2D& Min, const FVector2D& Max, TFunctionRef<void(const FCharacterEntry&)> Visit) const;
+
+    double CellSize;
+    double InvCellSize;
+
+    TArray<TWeakObjectPtr<AActor>> Managers;
+
+    // Dense entries, swap-removed; cells hold entry indices and are fixed up on removal
+    TArray<FCharacterEntry> Entries;
+    TMap<const ASurvivalCharacter*, int32> EntryIndices;
+    TMap<FIntPoint, TArray<int32, TInlineAllocator<4>>> Cells;
+};
\ No newline at end of file
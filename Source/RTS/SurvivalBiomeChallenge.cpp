@@ -1,4 +1,5 @@
 #include "SurvivalBiomeChallenge.h"
+#include "SurvivalActorRegistry.h"
 #include "SurvivalCharacter.h"
 #include "Engine/World.h"
 #include "Kismet/GameplayStatics.h"
@@ -24,9 +25,7 @@ void ASurvivalBiomeChallenge::BeginPlay()
     // Find BiomeManager if not manually assigned
     if (!BiomeManager)
     {
-        BiomeManager = Cast<ASurvivalBiomeManager>(
-            UGameplayStatics::GetActorOfClass(GetWorld(), ASurvivalBiomeManager::StaticClass())
-        );
+        BiomeManager = USurvivalActorRegistry::FindManager<ASurvivalBiomeManager>(this);
     }
     
     // Initialize all biome challenges
@@ -43,19 +42,23 @@ void ASurvivalBiomeChallenge::Tick(float DeltaTime)
     {
         ChallengeCheckTimer = 0.0f;
         
-        // Find all survival characters in the world
-        TArray<AActor*> FoundCharacters;
-        UGameplayStatics::GetAllActorsOfClass(GetWorld(), ASurvivalCharacter::StaticClass(), FoundCharacters);
+        USurvivalActorRegistry* Registry = USurvivalActorRegistry::Get(this);
+        if (!Registry)
+        {
+            return;
+        }
         
-        for (AActor* Actor : FoundCharacters)
+        // Each challenge asks the spatial hash for the characters in its radius instead of testing every
+        // character against every challenge. Per character, effects still apply in Alpine, Forest, River order.
+        TArray<ASurvivalCharacter*> CharactersInRange;
+        for (const TArray<FBiomeChallenge>* Challenges : { &AlpineChallenges, &ForestChallenges, &RiverChallenges })
         {
-            if (ASurvivalCharacter* Character = Cast<ASurvivalCharacter>(Actor))
+            for (const FBiomeChallenge& Challenge : *Challenges)
             {
-                FVector CharacterLocation = Character->GetActorLocation();
-                TArray<FBiomeChallenge> ActiveChallenges = GetActiveChallengesAtLocation(CharacterLocation);
+                CharactersInRange.Reset();
+                Registry->GetCharactersInRadius(Challenge.ChallengeLocation, Challenge.ActivationRadius, CharactersInRange);
                 
-                // Apply effects from active challenges
-                for (const FBiomeChallenge& Challenge : ActiveChallenges)
+                for (ASurvivalCharacter* Character : CharactersInRange)
                 {
                     ApplyChallengeEffects(Character, Challenge);
                 }
@@ -201,8 +204,12 @@ bool ASurvivalBiomeChallenge::IsLocationWithinChallenge(const FVector& WorldLoca
 
 float ASurvivalBiomeChallenge::CalculateAltitudeExposure(const FVector& WorldLocation) const
 {
-    // Exposure increases with altitude and distance from shelter
+    // Exposure increases with altitude and distance from shelter; terrain elevation when a heightmap exists
     float Elevation = WorldLocation.Z;
+    if (BiomeManager && BiomeManager->GetElevationQuery().IsValid())
+    {
+        Elevation = BiomeManager->GetElevationQuery().Sample(WorldLocation);
+    }
     float ExposureMultiplier = 1.0f + (Elevation / 1000.0f) * 0.3f; // +30% per 1000m elevation
     
     return FMath::Clamp(ExposureMultiplier, 1.0f, 2.0f);
@@ -1,19 +1,50 @@
 #include "SurvivalBiomeManager.h"
+#include "SurvivalTerrainDiskCache.h"
+#include "SurvivalTerrainKernels.h"
+#include "SurvivalActorRegistry.h"
 // Landscape includes removed for compilation
 #include "Engine/World.h"
 #include "Components/SplineComponent.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+#include "Net/UnrealNetwork.h"
+#include "TimerManager.h"
 
 ASurvivalBiomeManager::ASurvivalBiomeManager()
 {
     PrimaryActorTick.bCanEverTick = false;
     
+    // Only the seed and zone list go over the wire; every client builds the terrain itself
+    bReplicates = true;
+    bAlwaysRelevant = true;
+    
     // Default landscape settings for 5km race route
     LandscapeScale = 100.0f;
     HeightmapResolution = 1009; // Standard UE5 heightmap size (power of 2 + 1)
     MaxElevation = 2000.0f; // 2km elevation variation
     
-    // Initialize with default biome zones
+    // Tiled generation is bit-identical to the serial loop, just spread over worker threads
+    bUseTiledGeneration = true;
+    GenerationTileSize = FSurvivalTerrainTiling::DefaultTileSize;
+    
+    CourseSeed = 0;
+    TerrainNoiseOctaves = 1;
+    
+    // Erosion costs a few seconds per full regeneration, so courses opt in
+    bThermalErosion = false;
+    ThermalErosionIterations = 40;
+    TalusAngle = 35.0f;
+    bHydraulicErosion = false;
+    HydraulicErosionIterations = 60;
+    BiomeRasterCellSize = 5.0f; // 1000x500 cells, 1.5MB for both rasters
+    BiomeMultiplierFieldSpacing = 25.0f; // 201x101 samples
+    bCourseRebuildPending = false;
+    bHeightmapApplied = false;
+    
+    // Initialize with default biome zones. Only the zone index is built here, so zone scans work before
+    // PostInitializeComponents; the raster, field and terrain are built once there, not for every CDO and copy.
     InitializeBiomeZones();
+    BiomeZoneIndex.Build(BiomeZones);
 }
 
 void ASurvivalBiomeManager::BeginPlay()
@@ -21,6 +52,219 @@ void ASurvivalBiomeManager::BeginPlay()
     Super::BeginPlay();
 }
 
+void ASurvivalBiomeManager::PostInitializeComponents()
+{
+    Super::PostInitializeComponents();
+    
+    // Before any BeginPlay, so every consumer finds the manager through the registry
+    if (USurvivalActorRegistry* Registry = USurvivalActorRegistry::Get(this))
+    {
+        Registry->RegisterManager(this);
+    }
+    
+    // BiomeZones may have been overridden by level or blueprint data after construction
+    NotifyBiomeZonesChanged();
+}
+
+void ASurvivalBiomeManager::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+    
+    DOREPLIFETIME(ASurvivalBiomeManager, BiomeZones);
+    DOREPLIFETIME(ASurvivalBiomeManager, CourseSeed);
+}
+
+void ASurvivalBiomeManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    CancelTerrainGeneration();
+    
+    if (USurvivalActorRegistry* Registry = USurvivalActorRegistry::Get(this))
+    {
+        Registry->UnregisterManager(this);
+    }
+    
+    Super::EndPlay(EndPlayReason);
+}
+
+#if WITH_EDITOR
+void ASurvivalBiomeManager::PreEditChange(FProperty* PropertyAboutToChange)
+{
+    Super::PreEditChange(PropertyAboutToChange);
+    
+    // Snapshot the zones so the post-edit diff can find which ones moved
+    PreEditBiomeZones = BiomeZones;
+}
+
+void ASurvivalBiomeManager::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    
+    if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(ASurvivalBiomeManager, BiomeZones))
+    {
+        // Dirty area is every zone that was added, removed or edited, in both its old and new footprint
+        FBox2D DirtyWorldBounds(ForceInit);
+        const int32 NumCompared = FMath::Max(PreEditBiomeZones.Num(), BiomeZones.Num());
+        
+        for (int32 ZoneIndex = 0; ZoneIndex < NumCompared; ZoneIndex++)
+        {
+            const FBiomeZone* OldZone = PreEditBiomeZones.IsValidIndex(ZoneIndex) ? &PreEditBiomeZones[ZoneIndex] : nullptr;
+            const FBiomeZone* NewZone = BiomeZones.IsValidIndex(ZoneIndex) ? &BiomeZones[ZoneIndex] : nullptr;
+            
+            const bool bChanged = !OldZone || !NewZone
+                || OldZone->BiomeType != NewZone->BiomeType
+                || OldZone->CenterLocation != NewZone->CenterLocation
+                || OldZone->Radius != NewZone->Radius;
+            
+            if (bChanged)
+            {
+                if (OldZone)
+                {
+                    DirtyWorldBounds += GetBiomeZoneBounds(*OldZone);
+                }
+                if (NewZone)
+                {
+                    DirtyWorldBounds += GetBiomeZoneBounds(*NewZone);
+                }
+            }
+        }
+        
+        PreEditBiomeZones.Empty();
+        
+        // Multiplier-only edits leave the terrain untouched, but not the blended multipliers
+        if (DirtyWorldBounds.bIsValid)
+        {
+            RebuildBiomeLookups(DirtyWorldBounds);
+            HandleBiomeZonesChanged(DirtyWorldBounds);
+        }
+        else
+        {
+            BiomeZoneIndex.Build(BiomeZones);
+            BiomeMultiplierField.Build(BiomeZones, BiomeZoneIndex, GetHeightmapWorldExtent(), BiomeMultiplierFieldSpacing);
+        }
+    }
+    else if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(ASurvivalBiomeManager, BiomeRasterCellSize))
+    {
+        BiomeRaster.Build(BiomeZoneIndex, GetHeightmapWorldExtent(), BiomeRasterCellSize);
+    }
+    else if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(ASurvivalBiomeManager, BiomeMultiplierFieldSpacing))
+    {
+        BiomeMultiplierField.Build(BiomeZones, BiomeZoneIndex, GetHeightmapWorldExtent(), BiomeMultiplierFieldSpacing);
+    }
+}
+#endif
+
+void ASurvivalBiomeManager::NotifyBiomeZonesChanged()
+{
+    RebuildBiomeLookups(FBox2D(ForceInit));
+    HandleBiomeZonesChanged(FBox2D(ForceInit));
+}
+
+void ASurvivalBiomeManager::SetCourseSeed(int32 NewSeed)
+{
+    if (NewSeed == CourseSeed)
+    {
+        return;
+    }
+    
+    CourseSeed = NewSeed;
+    
+    // The seed feeds every elevation texel, so listeners regenerate the whole course
+    NotifyBiomeZonesChanged();
+}
+
+void ASurvivalBiomeManager::OnRep_CourseLayout()
+{
+    if (!bCourseRebuildPending)
+    {
+        bCourseRebuildPending = true;
+        GetWorldTimerManager().SetTimerForNextTick(this, &ASurvivalBiomeManager::RebuildReplicatedCourse);
+    }
+}
+
+void ASurvivalBiomeManager::OnRep_BiomeZones()
+{
+    // A shrunk list would leave raster zone indices pointing past its end until the deferred rebuild
+    RebuildBiomeLookups(FBox2D(ForceInit));
+    OnRep_CourseLayout();
+}
+
+void ASurvivalBiomeManager::RebuildReplicatedCourse()
+{
+    bCourseRebuildPending = false;
+    
+    // Regenerates whatever is already built; a client that has nothing yet starts building in the background.
+    // OnRep_BiomeZones already rebuilt the lookups for the replicated zones.
+    HandleBiomeZonesChanged(FBox2D(ForceInit));
+    if (!IsGeneratingTerrain() && !ElevationQuery.IsValid())
+    {
+        GenerateRaceLandscapeAsync();
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("Rebuilding replicated course: seed %d, %d biome zones"), CourseSeed, BiomeZones.Num());
+}
+
+void ASurvivalBiomeManager::UpdateBiomeZone(int32 ZoneIndex, const FBiomeZone& NewZone)
+{
+    if (!BiomeZones.IsValidIndex(ZoneIndex))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UpdateBiomeZone: invalid zone index %d (%d zones)"), ZoneIndex, BiomeZones.Num());
+        return;
+    }
+    
+    FBox2D DirtyWorldBounds = GetBiomeZoneBounds(BiomeZones[ZoneIndex]);
+    DirtyWorldBounds += GetBiomeZoneBounds(NewZone);
+    
+    BiomeZones[ZoneIndex] = NewZone;
+    RebuildBiomeLookups(DirtyWorldBounds);
+    HandleBiomeZonesChanged(DirtyWorldBounds);
+}
+
+void ASurvivalBiomeManager::RebuildBiomeLookups(const FBox2D& DirtyWorldBounds)
+{
+    BiomeZoneIndex.Build(BiomeZones);
+    BiomeRaster.Update(BiomeZoneIndex, DirtyWorldBounds, GetHeightmapWorldExtent(), BiomeRasterCellSize);
+    BiomeMultiplierField.Build(BiomeZones, BiomeZoneIndex, GetHeightmapWorldExtent(), BiomeMultiplierFieldSpacing);
+}
+
+void ASurvivalBiomeManager::HandleBiomeZonesChanged(const FBox2D& DirtyWorldBounds)
+{
+    // The pipeline must see the new layout before any listener asks it for terrain
+    TerrainPipeline.SetBiomeZones(BiomeZones, DirtyWorldBounds);
+    
+    // A background generation started from the old layout is stale; restart it rather than apply it. A new seed
+    // or replicated layout touches every texel, and erosion reworks the whole map after any edit, so those are
+    // whole generations and stay off the game thread too.
+    const bool bHasHeightmap = ElevationQuery.GetWidth() == HeightmapResolution && ElevationQuery.GetHeight() == HeightmapResolution;
+    const bool bWholeGeneration = !DirtyWorldBounds.bIsValid || GetErosionSettings().IsEnabled();
+    if (IsGeneratingTerrain() || (bHasHeightmap && bWholeGeneration))
+    {
+        GenerateRaceLandscapeAsync();
+    }
+    else if (bHasHeightmap)
+    {
+        SetGeneratedHeightData(GenerateHeightmapData());
+        ApplyGeneratedHeightmap();
+        
+        UE_LOG(LogTemp, Log, TEXT("Updated race heightmap after biome zone change"));
+    }
+    
+    OnBiomeZonesChanged.Broadcast(DirtyWorldBounds);
+}
+
+void ASurvivalBiomeManager::PopulateTerrainCache()
+{
+    // Actors loaded outside a game world never ran PostInitializeComponents
+    NotifyBiomeZonesChanged();
+    GenerateHeightmapData();
+}
+
+FBox2D ASurvivalBiomeManager::GetBiomeZoneBounds(const FBiomeZone& Zone)
+{
+    const FVector2D Center(Zone.CenterLocation.X, Zone.CenterLocation.Y);
+    const double Extent = FMath::Max(Zone.Radius, 0.0f);
+    return FBox2D(Center - FVector2D(Extent), Center + FVector2D(Extent));
+}
+
 void ASurvivalBiomeManager::InitializeBiomeZones()
 {
     BiomeZones.Empty();
@@ -108,96 +352,187 @@ void ASurvivalBiomeManager::GenerateRaceLandscape()
     }
     
     // Generate heightmap data based on biome layout
-    TArray<uint16> HeightData = GenerateHeightmapData();
+    SetGeneratedHeightData(GenerateHeightmapData());
     
     // Apply the heightmap to the landscape
-    ApplyHeightmapFromArray(HeightData);
+    ApplyGeneratedHeightmap();
     
     UE_LOG(LogTemp, Log, TEXT("Race landscape generated with %d biome zones"), BiomeZones.Num());
 }
 
-TArray<uint16> ASurvivalBiomeManager::GenerateHeightmapData()
+void ASurvivalBiomeManager::GenerateRaceLandscapeAsync()
 {
-    TArray<uint16> HeightData;
-    HeightData.SetNum(HeightmapResolution * HeightmapResolution);
+    if (!RaceLandscape)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("No landscape reference set in BiomeManager"));
+        return;
+    }
+    
+    // A newer request supersedes whatever is still running
+    CancelTerrainGeneration();
     
-    for (int32 Y = 0; Y < HeightmapResolution; Y++)
+    TSharedRef<FSurvivalTerrainJob> Job = MakeShared<FSurvivalTerrainJob>();
+    ActiveTerrainJob = Job;
+    
+    TWeakObjectPtr<ASurvivalBiomeManager> WeakThis(this);
+    const FSurvivalTerrainJob* JobPtr = &Job.Get();
+    Job->OnProgress = [WeakThis, JobPtr](float Progress)
     {
-        for (int32 X = 0; X < HeightmapResolution; X++)
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, JobPtr, Progress]
         {
-            // Convert heightmap coordinates to world coordinates
-            float WorldX = (X / float(HeightmapResolution - 1)) * 5000.0f; // 5km wide
-            float WorldY = (Y / float(HeightmapResolution - 1)) * 2500.0f; // 2.5km deep
-            
-            FVector WorldLocation(WorldX, WorldY, 0);
-            
-            // Calculate elevation based on biome influences
-            float Elevation = 0.0f;
-            float TotalInfluence = 0.0f;
-            
-            for (const FBiomeZone& Biome : BiomeZones)
+            ASurvivalBiomeManager* BiomeManager = WeakThis.Get();
+            if (BiomeManager && BiomeManager->ActiveTerrainJob.Get() == JobPtr)
             {
-                float Influence = GetBiomeInfluenceAtLocation(WorldLocation, Biome);
-                if (Influence > 0.0f)
-                {
-                    float BiomeBaseHeight = 0.0f;
-                    switch (Biome.BiomeType)
-                    {
-                        case EBiomeType::Alpine:
-                            BiomeBaseHeight = 1200.0f; // High elevation
-                            break;
-                        case EBiomeType::Forest:
-                            BiomeBaseHeight = 400.0f; // Medium elevation
-                            break;
-                        case EBiomeType::River:
-                            BiomeBaseHeight = 200.0f; // Low elevation
-                            break;
-                        case EBiomeType::Transition:
-                            BiomeBaseHeight = 600.0f; // Varied elevation
-                            break;
-                    }
-                    
-                    Elevation += BiomeBaseHeight * Influence;
-                    TotalInfluence += Influence;
-                }
+                BiomeManager->OnTerrainGenerationProgress.Broadcast(Progress);
             }
-            
-            if (TotalInfluence > 0.0f)
+        });
+    };
+    
+    FSurvivalTerrainRequest Request = MakeHeightmapRequest();
+    Request.Job = Job;
+    
+    // The worker runs on its own copy of the pipeline so zone edits and synchronous generation can't race it
+    TSharedRef<FSurvivalTerrainPipeline> Pipeline = MakeShared<FSurvivalTerrainPipeline>(TerrainPipeline);
+    
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Pipeline, Request, Erosion = GetErosionSettings()]
+    {
+        TArray<uint16> HeightData = BuildHeightmapData(*Pipeline, Request, Erosion);
+        
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Job = Request.Job, HeightData = MoveTemp(HeightData)]() mutable
+        {
+            ASurvivalBiomeManager* BiomeManager = WeakThis.Get();
+            if (!BiomeManager || BiomeManager->ActiveTerrainJob != Job)
             {
-                Elevation /= TotalInfluence;
+                return; // Cancelled or superseded
             }
             
-            // Add some noise for natural variation
-            float Noise = FMath::PerlinNoise2D(FVector2D(WorldX * 0.001f, WorldY * 0.001f)) * 100.0f;
-            Elevation += Noise;
+            BiomeManager->ActiveTerrainJob.Reset();
             
-            // Convert to heightmap format (0-65535)
-            uint16 HeightValue = FMath::Clamp(FMath::RoundToInt((Elevation / MaxElevation) * 65535.0f), 0, 65535);
+            if (HeightData.Num() == 0)
+            {
+                BiomeManager->OnRaceLandscapeGenerated.Broadcast(false);
+                return;
+            }
             
-            HeightData[Y * HeightmapResolution + X] = HeightValue;
-        }
+            BiomeManager->SetGeneratedHeightData(MoveTemp(HeightData));
+            BiomeManager->ApplyGeneratedHeightmap();
+            
+            UE_LOG(LogTemp, Log, TEXT("Race landscape generated in the background with %d biome zones"), BiomeManager->BiomeZones.Num());
+            BiomeManager->OnRaceLandscapeGenerated.Broadcast(true);
+        });
+    });
+}
+
+void ASurvivalBiomeManager::CancelTerrainGeneration()
+{
+    if (ActiveTerrainJob.IsValid())
+    {
+        ActiveTerrainJob->Cancel();
+        ActiveTerrainJob.Reset();
+    }
+}
+
+TArray<uint16> ASurvivalBiomeManager::GenerateHeightmapData()
+{
+    return BuildHeightmapData(TerrainPipeline, MakeHeightmapRequest(), GetErosionSettings());
+}
+
+FSurvivalTerrainErosionSettings ASurvivalBiomeManager::GetErosionSettings() const
+{
+    FSurvivalTerrainErosionSettings Settings;
+    Settings.bThermal = bThermalErosion;
+    Settings.ThermalIterations = ThermalErosionIterations;
+    Settings.TalusAngleDegrees = TalusAngle;
+    Settings.bHydraulic = bHydraulicErosion;
+    Settings.HydraulicIterations = HydraulicErosionIterations;
+    return Settings;
+}
+
+FSurvivalTerrainRequest ASurvivalBiomeManager::MakeHeightmapRequest() const
+{
+    FSurvivalTerrainRequest Request;
+    Request.Grid = FSurvivalTerrainGrid(HeightmapResolution, GetHeightmapWorldExtent());
+    Request.bUseTiledGeneration = bUseTiledGeneration;
+    Request.TileSize = GenerationTileSize;
+    Request.bGenerateElevation = true;
+    Request.Elevation = GetTerrainElevationSettings();
+    return Request;
+}
+
+FSurvivalTerrainElevationSettings ASurvivalBiomeManager::GetTerrainElevationSettings() const
+{
+    FSurvivalTerrainElevationSettings Settings;
+    Settings.MaxElevation = MaxElevation;
+    Settings.Seed = uint32(CourseSeed);
+    Settings.NoiseOctaves = TerrainNoiseOctaves;
+    return Settings;
+}
+
+TArray<uint16> ASurvivalBiomeManager::BuildHeightmapData(FSurvivalTerrainPipeline& Pipeline, const FSurvivalTerrainRequest& Request, const FSurvivalTerrainErosionSettings& Erosion)
+{
+    // A previous session may already have generated this exact heightmap
+    TArray<uint16> HeightData;
+    const uint64 StageHash = FSurvivalTerrainErosion::ChainHash(Pipeline.GetStageHash(Request, ESurvivalTerrainStage::Elevation), Erosion);
+    const uint64 CacheKey = FSurvivalTerrainDiskCache::MakeKey(StageHash, TEXT("BiomeManager.Heightmap"));
+    if (FSurvivalTerrainDiskCache::LoadHeights(CacheKey, Request.Grid.Resolution, Request.Grid.NumTexels(), HeightData))
+    {
+        return HeightData;
     }
     
+    // Same elevation stage the landscape manager uses, so both heightmaps agree for the same zones
+    const FSurvivalTerrainResult Result = Pipeline.Run(Request);
+    
+    if (!Result.Elevation.IsValid())
+    {
+        return HeightData;
+    }
+    
+    const TArray<float>& Elevation = Result.Elevation->Elevation;
+    HeightData.SetNumUninitialized(Elevation.Num());
+    
+    for (int32 TexelIndex = 0; TexelIndex < Elevation.Num(); TexelIndex++)
+    {
+        // Convert to heightmap format (0-65535)
+        HeightData[TexelIndex] = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt((Elevation[TexelIndex] / Request.Elevation.MaxElevation) * 65535.0f), 0, 65535));
+    }
+    
+    const FVector2D TexelSize = Request.Grid.WorldExtent / double(Request.Grid.Resolution - 1);
+    if (!FSurvivalTerrainErosion::Erode(HeightData, Request.Grid.Resolution, Request.Grid.Resolution, TexelSize, Request.Elevation.MaxElevation, Erosion, Request.TileSize, Request.Job.Get()))
+    {
+        return TArray<uint16>(); // Cancelled
+    }
+    
+    // Layouts mid-edit are rarely generated twice; only whole generations are worth a cache file
+    if (!Result.WasPatched())
+    {
+        FSurvivalTerrainDiskCache::StoreHeights(CacheKey, Request.Grid.Resolution, HeightData);
+    }
     return HeightData;
 }
 
-float ASurvivalBiomeManager::GetBiomeInfluenceAtLocation(const FVector& Location, const FBiomeZone& Biome) const
+void ASurvivalBiomeManager::SetGeneratedHeightData(TArray<uint16>&& HeightData)
 {
-    float Distance = FVector::Dist2D(Location, Biome.CenterLocation);
+    bHeightmapApplied = false;
     
-    if (Distance >= Biome.Radius)
+    // The elevation query owns the only retained copy; the landscape is given the same heights
+    if (HeightData.Num() == HeightmapResolution * HeightmapResolution)
     {
-        return 0.0f;
+        ElevationQuery.SetHeightmap(MoveTemp(HeightData), HeightmapResolution, HeightmapResolution, GetHeightmapWorldExtent(), MaxElevation);
+    }
+    else
+    {
+        ElevationQuery.Reset();
     }
-    
-    // Smooth falloff from center to edge
-    float Influence = 1.0f - (Distance / Biome.Radius);
-    return FMath::SmoothStep(0.0f, 1.0f, Influence);
 }
 
-void ASurvivalBiomeManager::ApplyHeightmapFromArray(const TArray<uint16>& HeightData)
+FVector2D ASurvivalBiomeManager::GetHeightmapWorldExtent() const
 {
-    if (!RaceLandscape || HeightData.Num() == 0)
+    return FVector2D(5000.0f, 2500.0f); // 5km wide, 2.5km deep
+}
+
+void ASurvivalBiomeManager::ApplyGeneratedHeightmap()
+{
+    if (!RaceLandscape || !ElevationQuery.IsValid())
     {
         return;
     }
@@ -211,39 +546,162 @@ void ASurvivalBiomeManager::ApplyHeightmapFromArray(const TArray<uint16>& Height
     // This would typically use the Landscape API to apply the heightmap
     // For now, we'll log that the data is ready for application
     UE_LOG(LogTemp, Log, TEXT("Heightmap data ready: %d values for %dx%d terrain"), 
-           HeightData.Num(), HeightmapResolution, HeightmapResolution);
+           ElevationQuery.GetHeightValues().Num(), ElevationQuery.GetWidth(), ElevationQuery.GetHeight());
+    
+    bHeightmapApplied = true;
 }
 
 EBiomeType ASurvivalBiomeManager::GetBiomeAtLocation(const FVector& WorldLocation) const
 {
-    float MaxInfluence = 0.0f;
-    EBiomeType DominantBiome = EBiomeType::Forest;
+    const int32 CellIndex = BiomeRaster.GetCellIndex(WorldLocation.X, WorldLocation.Y);
+    if (CellIndex != INDEX_NONE)
+    {
+        const uint8 Biome = BiomeRaster.GetBiome(CellIndex);
+        return Biome != FSurvivalBiomeRaster::NoBiome ? EBiomeType(Biome) : EBiomeType::Forest;
+    }
     
-    for (const FBiomeZone& Biome : BiomeZones)
+    const int32 ZoneIndex = FindDominantZoneIndex(WorldLocation);
+    return BiomeZones.IsValidIndex(ZoneIndex) ? BiomeZones[ZoneIndex].BiomeType : EBiomeType::Forest;
+}
+
+FBiomeZone ASurvivalBiomeManager::GetBiomeZoneAtLocation(const FVector& WorldLocation) const
+{
+    const FBiomeZone* Zone = FindBiomeZoneAtLocation(WorldLocation);
+    return Zone ? *Zone : FBiomeZone();
+}
+
+const FBiomeZone* ASurvivalBiomeManager::FindBiomeZoneAtLocation(const FVector& WorldLocation) const
+{
+    const int32 ZoneIndex = FindDominantZoneIndex(WorldLocation);
+    return BiomeZones.IsValidIndex(ZoneIndex) ? &BiomeZones[ZoneIndex] : nullptr;
+}
+
+void ASurvivalBiomeManager::GetBlendedBiomeMultipliersAtLocation(const FVector& WorldLocation, float& OutSpeedMultiplier, float& OutCalorieMultiplier) const
+{
+    const FVector2f Multipliers = BiomeMultiplierField.Sample(WorldLocation.X, WorldLocation.Y);
+    OutSpeedMultiplier = Multipliers.X;
+    OutCalorieMultiplier = Multipliers.Y;
+}
+
+void ASurvivalBiomeManager::GetBiomesAtLocations(const TArray<FVector>& WorldLocations, TArray<EBiomeType>& OutBiomes, TArray<int32>& OutZoneIndices,
+                                                 TArray<float>& OutSpeedMultipliers, TArray<float>& OutCalorieMultipliers) const
+{
+    const int32 Count = WorldLocations.Num();
+    OutBiomes.SetNumUninitialized(Count);
+    OutZoneIndices.SetNumUninitialized(Count);
+    OutSpeedMultipliers.SetNumUninitialized(Count);
+    OutCalorieMultipliers.SetNumUninitialized(Count);
+    
+    QueryBiomesAtLocations(WorldLocations.GetData(), Count, OutBiomes.GetData(), OutZoneIndices.GetData(), OutSpeedMultipliers.GetData(), OutCalorieMultipliers.GetData());
+}
+
+void ASurvivalBiomeManager::QueryBiomesAtLocations(const FVector* WorldLocations, int32 Count, EBiomeType* OutBiomes, int32* OutZoneIndices,
+                                                   float* OutSpeedMultipliers, float* OutCalorieMultipliers) const
+{
+    // Pass 1: raster lookups; misses are gathered as float SoA for the zone tests
+    TArray<int32, TInlineAllocator<64>> Misses;
+    TArray<float, TInlineAllocator<64>> MissX;
+    TArray<float, TInlineAllocator<64>> MissY;
+    FBox2D MissBounds(ForceInit);
+    
+    for (int32 Index = 0; Index < Count; Index++)
     {
-        float Influence = GetBiomeInfluenceAtLocation(WorldLocation, Biome);
-        if (Influence > MaxInfluence)
+        const FVector& Location = WorldLocations[Index];
+        const int32 CellIndex = BiomeRaster.GetCellIndex(Location.X, Location.Y);
+        if (CellIndex != INDEX_NONE)
         {
-            MaxInfluence = Influence;
-            DominantBiome = Biome.BiomeType;
+            OutZoneIndices[Index] = BiomeRaster.GetZoneIndex(CellIndex);
+        }
+        else
+        {
+            Misses.Add(Index);
+            MissX.Add(float(Location.X));
+            MissY.Add(float(Location.Y));
+            MissBounds += FVector2D(Location.X, Location.Y);
         }
     }
     
-    return DominantBiome;
+    // Pass 2: every zone that can reach a miss, four misses per distance test. Zones go in ascending order and
+    // only a strictly greater influence wins, the same tie rule as the single-location scan.
+    if (Misses.Num() > 0)
+    {
+        const int32 NumMisses = Misses.Num();
+        TArray<float, TInlineAllocator<64>> MaxInfluence;
+        TArray<float, TInlineAllocator<64>> Influence;
+        TArray<int32, TInlineAllocator<64>> DominantZone;
+        MaxInfluence.SetNumZeroed(NumMisses);
+        Influence.SetNumUninitialized(NumMisses);
+        DominantZone.Init(INDEX_NONE, NumMisses);
+        
+        TArray<int32> CandidateZones;
+        BiomeZoneIndex.GatherZonesOverlappingRect(MissBounds, CandidateZones);
+        
+        const TArray<double>& CentersX = BiomeZoneIndex.GetCentersX();
+        const TArray<double>& CentersY = BiomeZoneIndex.GetCentersY();
+        const TArray<float>& Radii = BiomeZoneIndex.GetRadii();
+        
+        for (int32 Zone : CandidateZones)
+        {
+            FSurvivalTerrainKernels::ZoneInfluenceBatch(MissX.GetData(), MissY.GetData(), float(CentersX[Zone]), float(CentersY[Zone]), Radii[Zone], Influence.GetData(), NumMisses);
+            
+            for (int32 Miss = 0; Miss < NumMisses; Miss++)
+            {
+                if (Influence[Miss] > MaxInfluence[Miss])
+                {
+                    MaxInfluence[Miss] = Influence[Miss];
+                    DominantZone[Miss] = Zone;
+                }
+            }
+        }
+        
+        for (int32 Miss = 0; Miss < NumMisses; Miss++)
+        {
+            OutZoneIndices[Misses[Miss]] = DominantZone[Miss];
+        }
+    }
+    
+    // Pass 3: per-zone fields for every location
+    for (int32 Index = 0; Index < Count; Index++)
+    {
+        const int32 Zone = OutZoneIndices[Index];
+        if (BiomeZones.IsValidIndex(Zone))
+        {
+            const FBiomeZone& BiomeZone = BiomeZones[Zone];
+            OutBiomes[Index] = BiomeZone.BiomeType;
+            OutSpeedMultipliers[Index] = BiomeZone.MovementSpeedMultiplier;
+            OutCalorieMultipliers[Index] = BiomeZone.CalorieBurnMultiplier;
+        }
+        else
+        {
+            OutZoneIndices[Index] = INDEX_NONE;
+            OutBiomes[Index] = EBiomeType::Forest;
+            OutSpeedMultipliers[Index] = 1.0f;
+            OutCalorieMultipliers[Index] = 1.0f;
+        }
+    }
 }
 
-FBiomeZone ASurvivalBiomeManager::GetBiomeZoneAtLocation(const FVector& WorldLocation) const
+int32 ASurvivalBiomeManager::FindDominantZoneIndex(const FVector& WorldLocation) const
 {
+    // On the course this is one lookup. The index can be stale when BiomeZones was written without a notify
+    // (Blueprint), so callers check it against BiomeZones before dereferencing.
+    const int32 CellIndex = BiomeRaster.GetCellIndex(WorldLocation.X, WorldLocation.Y);
+    if (CellIndex != INDEX_NONE)
+    {
+        return BiomeRaster.GetZoneIndex(CellIndex);
+    }
+    
     float MaxInfluence = 0.0f;
-    FBiomeZone DominantZone;
+    int32 DominantZone = INDEX_NONE;
     
-    for (const FBiomeZone& Biome : BiomeZones)
+    // Candidates come back in zone order, so ties resolve to the same zone as a full scan
+    for (int32 ZoneIndex : BiomeZoneIndex.GetCandidatesAtLocation(WorldLocation.X, WorldLocation.Y))
     {
-        float Influence = GetBiomeInfluenceAtLocation(WorldLocation, Biome);
+        float Influence = BiomeZoneIndex.GetInfluence(ZoneIndex, WorldLocation.X, WorldLocation.Y);
         if (Influence > MaxInfluence)
         {
             MaxInfluence = Influence;
-            DominantZone = Biome;
+            DominantZone = ZoneIndex;
         }
     }
     
@@ -259,12 +717,22 @@ void ASurvivalBiomeManager::CreateRaceSpline()
 
 float ASurvivalBiomeManager::GetElevationAtLocation(const FVector& WorldLocation) const
 {
-    if (!RaceLandscape)
-    {
-        return 0.0f;
-    }
-    
-    // Query landscape elevation at world location
-    // This would use the Landscape API to get actual height
-    return 0.0f;
+    // 0 until a heightmap has been generated
+    return ElevationQuery.Sample(WorldLocation);
+}
+
+void ASurvivalBiomeManager::GetElevationsAtLocations(const TArray<FVector>& WorldLocations, TArray<float>& OutElevations) const
+{
+    OutElevations.SetNumUninitialized(WorldLocations.Num());
+    ElevationQuery.SampleBatch(WorldLocations, OutElevations);
+}
+
+bool ASurvivalBiomeManager::RaycastTerrain(const FVector& Start, const FVector& End, FVector& OutHitLocation) const
+{
+    return ElevationQuery.RayCast(Start, End, OutHitLocation);
+}
+
+bool ASurvivalBiomeManager::HasTerrainLineOfSight(const FVector& From, const FVector& To) const
+{
+    return ElevationQuery.HasLineOfSight(From, To);
 }
\ No newline at end of file
@@ -3,6 +3,13 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "Engine/World.h"
+#include "SurvivalTerrainTiling.h"
+#include "SurvivalBiomeZoneIndex.h"
+#include "SurvivalBiomeRaster.h"
+#include "SurvivalBiomeMultiplierField.h"
+#include "SurvivalTerrainPipeline.h"
+#include "SurvivalElevationQuery.h"
+#include "SurvivalTerrainErosion.h"
 #include "SurvivalBiomeManager.generated.h"
 
 UENUM(BlueprintType)
@@ -44,6 +51,13 @@ struct FBiomeZone
     }
 };
 
+// DirtyWorldBounds covers every location whose biome influence may have changed; invalid bounds mean the whole course
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBiomeZonesChanged, FBox2D, DirtyWorldBounds);
+
+// Progress (0-1) and completion of background terrain generation, always broadcast on the game thread
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTerrainGenerationProgress, float, Progress);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTerrainGenerationCompleted, bool, bSucceeded);
+
 UCLASS(BlueprintType, Blueprintable)
 class RTS_API ASurvivalBiomeManager : public AActor
 {
@@ -54,12 +68,25 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void PostInitializeComponents() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+protected:
+#if WITH_EDITOR
+    virtual void PreEditChange(FProperty* PropertyAboutToChange) override;
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Landscape")
     class AActor* RaceLandscape;
 
 public:
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Biomes")
+    // Replicated with CourseSeed: clients regenerate the heightmap locally instead of receiving it.
+    // Blueprints that write this must call NotifyBiomeZonesChanged before the next location query.
+    UPROPERTY(ReplicatedUsing = OnRep_BiomeZones, EditAnywhere, BlueprintReadWrite, Category = "Biomes")
     TArray<FBiomeZone> BiomeZones;
 
 protected:
@@ -76,26 +103,173 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terrain")
     float MaxElevation;
 
+    // Split heightmap generation into tiles processed in parallel (see rts.Terrain.GenerationThreads)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terrain|Performance")
+    bool bUseTiledGeneration;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terrain|Performance", meta = (ClampMin = "8"))
+    int32 GenerationTileSize;
+
+    // Seeds every terrain noise octave; 0 keeps the original course. Set through SetCourseSeed at runtime.
+    UPROPERTY(ReplicatedUsing = OnRep_CourseLayout, EditAnywhere, BlueprintReadOnly, Category = "Terrain")
+    int32 CourseSeed;
+
+    // fBm octaves of the course-wide terrain variation
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terrain", meta = (ClampMin = "1", ClampMax = "8"))
+    int32 TerrainNoiseOctaves;
+
+    // Slopes steeper than TalusAngle slump into screes after generation (see FSurvivalTerrainErosion)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terrain|Erosion")
+    bool bThermalErosion;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terrain|Erosion", meta = (ClampMin = "0"))
+    int32 ThermalErosionIterations;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terrain|Erosion", meta = (ClampMin = "0", ClampMax = "89"))
+    float TalusAngle;
+
+    // Rain-driven sediment transport that cuts gullies and fills valley floors
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terrain|Erosion")
+    bool bHydraulicErosion;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terrain|Erosion", meta = (ClampMin = "0"))
+    int32 HydraulicErosionIterations;
+
+    // Cell size (world units) of the baked biome raster behind GetBiomeAtLocation; biome borders are exact to half a cell
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Biomes|Performance", meta = (ClampMin = "1"))
+    float BiomeRasterCellSize;
+
+    // Sample spacing (world units) of the blended speed/calorie multiplier field
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Biomes|Performance", meta = (ClampMin = "1"))
+    float BiomeMultiplierFieldSpacing;
+
 public:
     UFUNCTION(BlueprintCallable, Category = "Landscape")
     void GenerateRaceLandscape();
 
+    // GenerateRaceLandscape on worker threads. Cancels any generation still running; the heightmap is
+    // applied on the game thread and OnRaceLandscapeGenerated fires once it is.
+    UFUNCTION(BlueprintCallable, Category = "Landscape")
+    void GenerateRaceLandscapeAsync();
+
+    UFUNCTION(BlueprintCallable, Category = "Landscape")
+    void CancelTerrainGeneration();
+
+    UFUNCTION(BlueprintCallable, Category = "Landscape")
+    bool IsGeneratingTerrain() const { return ActiveTerrainJob.IsValid(); }
+
+    UPROPERTY(BlueprintAssignable, Category = "Landscape")
+    FOnTerrainGenerationProgress OnTerrainGenerationProgress;
+
+    UPROPERTY(BlueprintAssignable, Category = "Landscape")
+    FOnTerrainGenerationCompleted OnRaceLandscapeGenerated;
+
+    // Server only; regenerates the whole course, and clients follow once the seed replicates
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Terrain")
+    void SetCourseSeed(int32 NewSeed);
+
+    UFUNCTION(BlueprintCallable, Category = "Terrain")
+    int32 GetCourseSeed() const { return CourseSeed; }
+
+    int32 GetTerrainNoiseOctaves() const { return TerrainNoiseOctaves; }
+
+    // Erosion applied to every heightmap generated for this course, including the landscape manager's
+    FSurvivalTerrainErosionSettings GetErosionSettings() const;
+
+    // Elevation model of the race heightmap; other requests use it to share the pipeline's cached elevation
+    FSurvivalTerrainElevationSettings GetTerrainElevationSettings() const;
+
     UFUNCTION(BlueprintCallable, Category = "Biomes")
     EBiomeType GetBiomeAtLocation(const FVector& WorldLocation) const;
 
     UFUNCTION(BlueprintCallable, Category = "Biomes") 
     FBiomeZone GetBiomeZoneAtLocation(const FVector& WorldLocation) const;
 
+    // Dominant zone without copying it; null where no zone reaches
+    const FBiomeZone* FindBiomeZoneAtLocation(const FVector& WorldLocation) const;
+
+    // GetBiomeZoneAtLocation for many locations at once, written structure-of-arrays. Locations on the course
+    // read the biome raster; the rest are tested against every zone four at a time. Zone index is INDEX_NONE
+    // and the multipliers 1 where no zone reaches.
+    UFUNCTION(BlueprintCallable, Category = "Biomes")
+    void GetBiomesAtLocations(const TArray<FVector>& WorldLocations, TArray<EBiomeType>& OutBiomes, TArray<int32>& OutZoneIndices,
+                              TArray<float>& OutSpeedMultipliers, TArray<float>& OutCalorieMultipliers) const;
+
+    // Speed and calorie multipliers blended by zone influence, so they change smoothly across borders
+    UFUNCTION(BlueprintCallable, Category = "Biomes")
+    void GetBlendedBiomeMultipliersAtLocation(const FVector& WorldLocation, float& OutSpeedMultiplier, float& OutCalorieMultiplier) const;
+
+    // GetBiomesAtLocations into caller-owned storage; every output holds Count entries
+    void QueryBiomesAtLocations(const FVector* WorldLocations, int32 Count, EBiomeType* OutBiomes, int32* OutZoneIndices,
+                                float* OutSpeedMultipliers, float* OutCalorieMultipliers) const;
+
     UFUNCTION(BlueprintCallable, Category = "Race Route")
     void CreateRaceSpline();
 
+    // Bilinear lookup into the generated heightmap; 0 before one exists
     UFUNCTION(BlueprintCallable, Category = "Terrain")
     float GetElevationAtLocation(const FVector& WorldLocation) const;
 
+    UFUNCTION(BlueprintCallable, Category = "Terrain")
+    void GetElevationsAtLocations(const TArray<FVector>& WorldLocations, TArray<float>& OutElevations) const;
+
+    // Traces against the generated heightmap instead of collision, so it also works before the landscape is
+    // applied and for teammate and beacon visibility checks at any range. False before a heightmap exists.
+    UFUNCTION(BlueprintCallable, Category = "Terrain")
+    bool RaycastTerrain(const FVector& Start, const FVector& End, FVector& OutHitLocation) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Terrain")
+    bool HasTerrainLineOfSight(const FVector& From, const FVector& To) const;
+
+    // Hands the elevation query's heights to RaceLandscape
     UFUNCTION(Category = "Terrain")
-    void ApplyHeightmapFromArray(const TArray<uint16>& HeightData);
+    void ApplyGeneratedHeightmap();
+
+    // Must be called after BiomeZones is modified at runtime so spatial queries see the new layout.
+    // Treats the whole course as dirty; prefer UpdateBiomeZone when a single zone moves.
+    UFUNCTION(BlueprintCallable, Category = "Biomes")
+    void NotifyBiomeZonesChanged();
+
+    // Replaces one zone and regenerates only the terrain covered by its old and new footprint
+    UFUNCTION(BlueprintCallable, Category = "Biomes")
+    void UpdateBiomeZone(int32 ZoneIndex, const FBiomeZone& NewZone);
+
+    UPROPERTY(BlueprintAssignable, Category = "Biomes")
+    FOnBiomeZonesChanged OnBiomeZonesChanged;
+
+    static FBox2D GetBiomeZoneBounds(const FBiomeZone& Zone);
+
+    const FSurvivalBiomeZoneIndex& GetBiomeZoneIndex() const { return BiomeZoneIndex; }
+
+    // Dominant biome and zone per cell over the course, kept current by zone edits
+    const FSurvivalBiomeRaster& GetBiomeRaster() const { return BiomeRaster; }
+
+    const FSurvivalBiomeMultiplierField& GetBiomeMultiplierField() const { return BiomeMultiplierField; }
+
+    // Heights of the last generated heightmap, for C++ callers that want bicubic or batched sampling
+    const FSurvivalElevationQuery& GetElevationQuery() const { return ElevationQuery; }
+
+    // True once the current heightmap was handed to RaceLandscape. Before that the elevation query
+    // describes terrain nothing in the level stands on, so placement should not snap to it.
+    bool IsHeightmapApplied() const { return bHeightmapApplied; }
+
+    // Shared generation stages; the landscape manager and texture blender run their requests through this
+    FSurvivalTerrainPipeline& GetTerrainPipeline() { return TerrainPipeline; }
+
+    // Generates the race heightmap into the terrain disk cache without applying it (used by the cache commandlet)
+    void PopulateTerrainCache();
 
 private:
+    UFUNCTION()
+    void OnRep_CourseLayout();
+
+    // Location queries index BiomeZones through the raster, so those are rebuilt on arrival; only the terrain waits
+    UFUNCTION()
+    void OnRep_BiomeZones();
+
+    // Seed and zones arrive as separate rep notifies; rebuild once for both
+    void RebuildReplicatedCourse();
+
     void InitializeBiomeZones();
     void CreateAlpineBiome();
     void CreateForestBiome(); 
@@ -103,5 +277,36 @@ private:
     void CreateTransitionZones();
     
     TArray<uint16> GenerateHeightmapData();
-    float GetBiomeInfluenceAtLocation(const FVector& Location, const FBiomeZone& Biome) const;
+    FSurvivalTerrainRequest MakeHeightmapRequest() const;
+    FVector2D GetHeightmapWorldExtent() const;
+    void SetGeneratedHeightData(TArray<uint16>&& HeightData);
+
+    // Safe on worker threads as long as Pipeline is not shared with the game thread
+    static TArray<uint16> BuildHeightmapData(FSurvivalTerrainPipeline& Pipeline, const FSurvivalTerrainRequest& Request, const FSurvivalTerrainErosionSettings& Erosion);
+
+    // Zone index, raster and multiplier field; everything a location query reads
+    void RebuildBiomeLookups(const FBox2D& DirtyWorldBounds);
+
+    // Terrain and listeners; expects the lookups to be current already
+    void HandleBiomeZonesChanged(const FBox2D& DirtyWorldBounds);
+    int32 FindDominantZoneIndex(const FVector& WorldLocation) const;
+
+    FSurvivalBiomeZoneIndex BiomeZoneIndex;
+    FSurvivalBiomeRaster BiomeRaster;
+    FSurvivalBiomeMultiplierField BiomeMultiplierField;
+    FSurvivalTerrainPipeline TerrainPipeline;
+
+    // Owns the last generated heightmap; zone edits refresh it through the pipeline's dirty-region patching
+    FSurvivalElevationQuery ElevationQuery;
+
+    // Job of the GenerateRaceLandscapeAsync call whose result is still wanted
+    TSharedPtr<FSurvivalTerrainJob> ActiveTerrainJob;
+
+    bool bCourseRebuildPending;
+
+    bool bHeightmapApplied;
+
+#if WITH_EDITOR
+    TArray<FBiomeZone> PreEditBiomeZones;
+#endif
 };
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "SurvivalBiomeMultiplierField.h"
+#include "SurvivalBiomeManager.h"
+
+FSurvivalBiomeMultiplierField::FSurvivalBiomeMultiplierField()
+{
+    Reset();
+}
+
+void FSurvivalBiomeMultiplierField::Reset()
+{
+    SamplesX = 0;
+    SamplesY = 0;
+    SamplesPerUnit = FVector2D::ZeroVector;
+    Samples.Reset();
+}
+
+void FSurvivalBiomeMultiplierField::Build(const TArray<FBiomeZone>& Zones, const FSurvivalBiomeZoneIndex& ZoneIndex, const FVector2D& WorldExtent, float SampleSpacing)
+{
+    Reset();
+
+    if (SampleSpacing <= 0.0f || WorldExtent.X <= 0.0 || WorldExtent.Y <= 0.0)
+    {
+        return;
+    }
+
+    SamplesX = FMath::Max(FMath::CeilToInt32(WorldExtent.X / SampleSpacing), 1) + 1;
+    SamplesY = FMath::Max(FMath::CeilToInt32(WorldExtent.Y / SampleSpacing), 1) + 1;
+    SamplesPerUnit = FVector2D((SamplesX - 1) / WorldExtent.X, (SamplesY - 1) / WorldExtent.Y);
+    Samples.SetNumUninitialized(SamplesX * SamplesY);
+
+    // About 20k samples at the default spacing; cheap enough to rebuild whole on every zone edit
+    for (int32 SampleY = 0; SampleY < SamplesY; SampleY++)
+    {
+        const double Y = SampleY / SamplesPerUnit.Y;
+
+        for (int32 SampleX = 0; SampleX < SamplesX; SampleX++)
+        {
+            const double X = SampleX / SamplesPerUnit.X;
+
+            float InfluenceSum = 0.0f;
+            FVector2f WeightedSum = FVector2f::ZeroVector;
+            for (int32 Zone : ZoneIndex.GetCandidatesAtLocation(X, Y))
+            {
+                const float Influence = ZoneIndex.GetInfluence(Zone, X, Y);
+                InfluenceSum += Influence;
+                WeightedSum += FVector2f(Zones[Zone].MovementSpeedMultiplier, Zones[Zone].CalorieBurnMultiplier) * Influence;
+            }
+
+            // Where the zones' influence doesn't add up to 1 the rest is open ground at the default multipliers,
+            // so a lone zone fades out to 1 across its falloff instead of stepping at its edge
+            const float DefaultWeight = 1.0f - FMath::Min(InfluenceSum, 1.0f);
+            Samples[SampleY * SamplesX + SampleX] = (WeightedSum + FVector2f(DefaultWeight, DefaultWeight)) / FMath::Max(InfluenceSum, 1.0f);
+        }
+    }
+}
+
+FVector2f FSurvivalBiomeMultiplierField::Sample(double X, double Y) const
+{
+    if (!IsValid())
+    {
+        return FVector2f(1.0f, 1.0f);
+    }
+
+    const double GridX = FMath::Clamp(X * SamplesPerUnit.X, 0.0, double(SamplesX - 1));
+    const double GridY = FMath::Clamp(Y * SamplesPerUnit.Y, 0.0, double(SamplesY - 1));
+    const int32 X0 = FMath::Min(FMath::FloorToInt32(GridX), FMath::Max(SamplesX - 2, 0));
+    const int32 Y0 = FMath::Min(FMath::FloorToInt32(GridY), FMath::Max(SamplesY - 2, 0));
+    const int32 X1 = FMath::Min(X0 + 1, SamplesX - 1);
+    const int32 Y1 = FMath::Min(Y0 + 1, SamplesY - 1);
+    const float FracX = float(GridX - X0);
+    const float FracY = float(GridY - Y0);
+
+    const FVector2f Bottom = FMath::Lerp(Samples[Y0 * SamplesX + X0], Samples[Y0 * SamplesX + X1], FracX);
+    const FVector2f Top = FMath::Lerp(Samples[Y1 * SamplesX + X0], Samples[Y1 * SamplesX + X1], FracX);
+    return FMath::Lerp(Bottom, Top, FracY);
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FBiomeZone;
+class FSurvivalBiomeZoneIndex;
+
+// Influence-weighted movement speed (X) and calorie burn (Y) multipliers on a coarse grid over the course,
+// sampled bilinearly so they blend across zone borders and Transition overlaps instead of stepping.
+// Samples sit on grid corners, like heightmap texels: SamplesX spans [0, WorldExtent.X] inclusive.
+class RTS_API FSurvivalBiomeMultiplierField
+{
+public:
+    FSurvivalBiomeMultiplierField();
+
+    // Each sample is (sum(influence * multiplier) + max(1 - sum(influence), 0)) / max(sum(influence), 1) over the
+    // zones reaching it: total influence short of 1 is filled with the default multiplier of 1
+    void Build(const TArray<FBiomeZone>& Zones, const FSurvivalBiomeZoneIndex& ZoneIndex, const FVector2D& WorldExtent, float SampleSpacing);
+    void Reset();
+
+    bool IsValid() const { return Samples.Num() > 0; }
+
+    // Locations off the course take the nearest edge value
+    FVector2f Sample(double X, double Y) const;
+
+    int32 GetSamplesX() const { return SamplesX; }
+    int32 GetSamplesY() const { return SamplesY; }
+
+    // Row-major, SamplesX per row
+    const TArray<FVector2f>& GetSamples() const { return Samples; }
+
+private:
+    int32 SamplesX;
+    int32 SamplesY;
+    FVector2D SamplesPerUnit;
+    TArray<FVector2f> Samples;
+};
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "SurvivalBiomeRaster.h"
+#include "SurvivalBiomeManager.h"
+
+FSurvivalBiomeRaster::FSurvivalBiomeRaster()
+{
+    Reset();
+}
+
+void FSurvivalBiomeRaster::Reset()
+{
+    CellSize = 1.0f;
+    InvCellSize = 1.0;
+    CellsX = 0;
+    CellsY = 0;
+    WorldExtent = FVector2D::ZeroVector;
+    NumZones = 0;
+    Biomes.Reset();
+    Zones.Reset();
+}
+
+void FSurvivalBiomeRaster::Build(const FSurvivalBiomeZoneIndex& ZoneIndex, const FVector2D& InWorldExtent, float InCellSize)
+{
+    Reset();
+
+    // Zone indices have to fit the uint16 raster; callers fall back to the zone index past that
+    if (InCellSize <= 0.0f || ZoneIndex.Num() >= NoZone)
+    {
+        return;
+    }
+
+    CellSize = InCellSize;
+    InvCellSize = 1.0 / InCellSize;
+    CellsX = FMath::Max(FMath::CeilToInt32(InWorldExtent.X * InvCellSize), 1);
+    CellsY = FMath::Max(FMath::CeilToInt32(InWorldExtent.Y * InvCellSize), 1);
+    WorldExtent = InWorldExtent;
+    NumZones = ZoneIndex.Num();
+
+    Biomes.SetNumUninitialized(CellsX * CellsY);
+    Zones.SetNumUninitialized(CellsX * CellsY);
+
+    BakeRegion(ZoneIndex, FSurvivalTerrainTile(0, 0, CellsX, CellsY));
+}
+
+void FSurvivalBiomeRaster::Update(const FSurvivalBiomeZoneIndex& ZoneIndex, const FBox2D& DirtyWorldBounds, const FVector2D& InWorldExtent, float InCellSize)
+{
+    if (!IsValid() || !DirtyWorldBounds.bIsValid || ZoneIndex.Num() != NumZones || InWorldExtent != WorldExtent || InCellSize != CellSize)
+    {
+        Build(ZoneIndex, InWorldExtent, InCellSize);
+        return;
+    }
+
+    const FSurvivalTerrainTile Region(
+        FMath::Clamp(FMath::FloorToInt32(DirtyWorldBounds.Min.X * InvCellSize), 0, CellsX),
+        FMath::Clamp(FMath::FloorToInt32(DirtyWorldBounds.Min.Y * InvCellSize), 0, CellsY),
+        FMath::Clamp(FMath::CeilToInt32(DirtyWorldBounds.Max.X * InvCellSize) + 1, 0, CellsX),
+        FMath::Clamp(FMath::CeilToInt32(DirtyWorldBounds.Max.Y * InvCellSize) + 1, 0, CellsY));
+
+    if (!Region.IsEmpty())
+    {
+        BakeRegion(ZoneIndex, Region);
+    }
+}
+
+void FSurvivalBiomeRaster::BakeRegion(const FSurvivalBiomeZoneIndex& ZoneIndex, const FSurvivalTerrainTile& Region)
+{
+    TArray<FSurvivalTerrainTile> Tiles;
+    FSurvivalTerrainTiling::BuildTiles(Region, FSurvivalTerrainTiling::DefaultTileSize, Tiles);
+
+    FSurvivalTerrainTiling::ParallelForEachTile(Tiles, [this, &ZoneIndex](const FSurvivalTerrainTile& Tile)
+    {
+        for (int32 CellY = Tile.MinY; CellY < Tile.MaxY; CellY++)
+        {
+            const double Y = (CellY + 0.5) * CellSize;
+
+            for (int32 CellX = Tile.MinX; CellX < Tile.MaxX; CellX++)
+            {
+                const double X = (CellX + 0.5) * CellSize;
+
+                // Same rule as ASurvivalBiomeManager's zone scan: strictly greater influence, ascending candidates
+                float MaxInfluence = 0.0f;
+                int32 DominantZone = INDEX_NONE;
+                for (int32 Zone : ZoneIndex.GetCandidatesAtLocation(X, Y))
+                {
+                    const float Influence = ZoneIndex.GetInfluence(Zone, X, Y);
+                    if (Influence > MaxInfluence)
+                    {
+                        MaxInfluence = Influence;
+                        DominantZone = Zone;
+                    }
+                }
+
+                const int32 CellIndex = CellY * CellsX + CellX;
+                Zones[CellIndex] = DominantZone != INDEX_NONE ? uint16(DominantZone) : NoZone;
+                Biomes[CellIndex] = DominantZone != INDEX_NONE ? uint8(ZoneIndex.GetBiomeType(DominantZone)) : NoBiome;
+            }
+        }
+    });
+}
+
+float FSurvivalBiomeRaster::GetDistanceToZoneBoundary(int32 CellIndex, float MaxDistance) const
+{
+    const uint16 Zone = Zones[CellIndex];
+    const int32 CellX = CellIndex % CellsX;
+    const int32 CellY = CellIndex / CellsX;
+    const int32 MaxRing = FMath::Min(FMath::CeilToInt32(MaxDistance * InvCellSize), MaxBoundarySearchCells);
+
+    int32 BestDistanceSq = MAX_int32;
+    for (int32 Ring = 1; Ring <= MaxRing; Ring++)
+    {
+        // Every cell on ring R is at least R cells away, so a closer hit already found can't be beaten
+        if (Ring * Ring >= BestDistanceSq)
+        {
+            break;
+        }
+
+        for (int32 DY = -Ring; DY <= Ring; DY++)
+        {
+            const int32 Y = CellY + DY;
+            if (Y < 0 || Y >= CellsY)
+            {
+                continue;
+            }
+
+            // Full rows on the top and bottom edge of the ring, just the two ends in between
+            const int32 StepX = (DY == -Ring || DY == Ring) ? 1 : Ring * 2;
+            for (int32 DX = -Ring; DX <= Ring; DX += StepX)
+            {
+                const int32 X = CellX + DX;
+                if (X >= 0 && X < CellsX && Zones[Y * CellsX + X] != Zone)
+                {
+                    BestDistanceSq = FMath::Min(BestDistanceSq, DX * DX + DY * DY);
+                }
+            }
+        }
+    }
+
+    if (BestDistanceSq == MAX_int32)
+    {
+        return MaxDistance;
+    }
+
+    return FMath::Min(FMath::Sqrt(float(BestDistanceSq)) * CellSize, MaxDistance);
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SurvivalTerrainTiling.h"
+
+class FSurvivalBiomeZoneIndex;
+
+// Dominant biome and zone of every cell over the course, baked from the zone index so location queries are a
+// single array lookup. Cells are sampled at their center; borders are exact to within half a cell.
+class RTS_API FSurvivalBiomeRaster
+{
+public:
+    // Stored for cells no zone reaches
+    static constexpr uint8 NoBiome = 0xFF;
+    static constexpr uint16 NoZone = 0xFFFF;
+
+    FSurvivalBiomeRaster();
+
+    // Covers [0, WorldExtent] with square cells of CellSize world units
+    void Build(const FSurvivalBiomeZoneIndex& Zones, const FVector2D& WorldExtent, float CellSize);
+
+    // Re-bakes only the cells inside DirtyWorldBounds. Falls back to a full Build when the zone count, extent
+    // or cell size changed, or DirtyWorldBounds is invalid (the whole course).
+    void Update(const FSurvivalBiomeZoneIndex& Zones, const FBox2D& DirtyWorldBounds, const FVector2D& WorldExtent, float CellSize);
+
+    void Reset();
+
+    bool IsValid() const { return Biomes.Num() > 0; }
+
+    // INDEX_NONE outside the course
+    FORCEINLINE int32 GetCellIndex(double X, double Y) const
+    {
+        const int32 CellX = FMath::FloorToInt32(X * InvCellSize);
+        const int32 CellY = FMath::FloorToInt32(Y * InvCellSize);
+        if (CellX < 0 || CellY < 0 || CellX >= CellsX || CellY >= CellsY)
+        {
+            return INDEX_NONE;
+        }
+        return CellY * CellsX + CellX;
+    }
+
+    // EBiomeType as uint8, or NoBiome
+    uint8 GetBiome(int32 CellIndex) const { return Biomes[CellIndex]; }
+
+    // Index into the zones the raster was built from, or INDEX_NONE
+    int32 GetZoneIndex(int32 CellIndex) const { return Zones[CellIndex] == NoZone ? INDEX_NONE : int32(Zones[CellIndex]); }
+
+    // Center-to-center distance to the nearest cell whose dominant zone differs, searched out to MaxDistance
+    // (and at most MaxBoundarySearchCells rings). Returns MaxDistance when no such cell is that close.
+    float GetDistanceToZoneBoundary(int32 CellIndex, float MaxDistance) const;
+
+    static constexpr int32 MaxBoundarySearchCells = 16;
+
+    int32 GetCellsX() const { return CellsX; }
+    int32 GetCellsY() const { return CellsY; }
+    float GetCellSize() const { return CellSize; }
+
+    // Row-major, CellsX per row
+    const TArray<uint8>& GetBiomes() const { return Biomes; }
+    const TArray<uint16>& GetZones() const { return Zones; }
+
+private:
+    void BakeRegion(const FSurvivalBiomeZoneIndex& ZoneIndex, const FSurvivalTerrainTile& Region);
+
+    float CellSize;
+    double InvCellSize;
+    int32 CellsX;
+    int32 CellsY;
+    FVector2D WorldExtent;
+    int32 NumZones;
+
+    TArray<uint8> Biomes;
+    TArray<uint16> Zones;
+};
\ No newline at end of file
@@ -0,0 +1,191 @@
+#include "SurvivalBiomeZoneIndex.h"
+#include "SurvivalBiomeManager.h"
+
+namespace SurvivalBiomeZoneIndexConstants
+{
+    // Caps the grid at 256x256 cells however small the zones get
+    constexpr int32 MaxCellsPerAxis = 256;
+
+    // Padding (world units) applied to rect queries so float rounding can't cull a touching zone
+    constexpr double RectQueryPadding = 1.0;
+}
+
+FSurvivalBiomeZoneIndex::FSurvivalBiomeZoneIndex()
+{
+    Reset();
+}
+
+void FSurvivalBiomeZoneIndex::Reset()
+{
+    CenterX.Reset();
+    CenterY.Reset();
+    Radius.Reset();
+    BiomeTypes.Reset();
+    CellStart.Reset();
+    CellZones.Reset();
+
+    GridOrigin = FVector2D::ZeroVector;
+    CellSize = 1.0;
+    InvCellSize = 1.0;
+    CellsX = 0;
+    CellsY = 0;
+}
+
+void FSurvivalBiomeZoneIndex::Build(const TArray<FBiomeZone>& Zones)
+{
+    using namespace SurvivalBiomeZoneIndexConstants;
+
+    Reset();
+
+    const int32 NumZones = Zones.Num();
+    if (NumZones == 0)
+    {
+        return;
+    }
+
+    CenterX.SetNumUninitialized(NumZones);
+    CenterY.SetNumUninitialized(NumZones);
+    Radius.SetNumUninitialized(NumZones);
+    BiomeTypes.SetNumUninitialized(NumZones);
+
+    FBox2D Bounds(ForceInit);
+    double DiameterSum = 0.0;
+
+    for (int32 ZoneIndex = 0; ZoneIndex < NumZones; ZoneIndex++)
+    {
+        const FBiomeZone& Zone = Zones[ZoneIndex];
+        const double ZoneRadius = FMath::Max(Zone.Radius, 0.0f);
+
+        CenterX[ZoneIndex] = Zone.CenterLocation.X;
+        CenterY[ZoneIndex] = Zone.CenterLocation.Y;
+        Radius[ZoneIndex] = Zone.Radius;
+        BiomeTypes[ZoneIndex] = Zone.BiomeType;
+
+        Bounds += FVector2D(Zone.CenterLocation.X - ZoneRadius, Zone.CenterLocation.Y - ZoneRadius);
+        Bounds += FVector2D(Zone.CenterLocation.X + ZoneRadius, Zone.CenterLocation.Y + ZoneRadius);
+        DiameterSum += ZoneRadius * 2.0;
+    }
+
+    // Cells about one average zone across keep candidate lists short without exploding cell count
+    const FVector2D Extent = Bounds.GetSize();
+    const double LargestExtent = FMath::Max3(Extent.X, Extent.Y, 1.0);
+    CellSize = FMath::Max(DiameterSum / NumZones, LargestExtent / MaxCellsPerAxis);
+    CellSize = FMath::Max(CellSize, 1.0);
+    InvCellSize = 1.0 / CellSize;
+
+    GridOrigin = Bounds.Min;
+    CellsX = FMath::Clamp(FMath::CeilToInt32(Extent.X * InvCellSize), 1, MaxCellsPerAxis);
+    CellsY = FMath::Clamp(FMath::CeilToInt32(Extent.Y * InvCellSize), 1, MaxCellsPerAxis);
+
+    auto ForEachCoveredCell = [this](int32 ZoneIndex, TFunctionRef<void(int32)> Visit)
+    {
+        const double ZoneRadius = FMath::Max(Radius[ZoneIndex], 0.0f);
+        int32 MinCellX, MinCellY, MaxCellX, MaxCellY;
+        GetCellCoords(CenterX[ZoneIndex] - ZoneRadius, CenterY[ZoneIndex] - ZoneRadius, MinCellX, MinCellY);
+        GetCellCoords(CenterX[ZoneIndex] + ZoneRadius, CenterY[ZoneIndex] + ZoneRadius, MaxCellX, MaxCellY);
+
+        for (int32 CellY = MinCellY; CellY <= MaxCellY; CellY++)
+        {
+            for (int32 CellX = MinCellX; CellX <= MaxCellX; CellX++)
+            {
+                Visit(CellY * CellsX + CellX);
+            }
+        }
+    };
+
+    // Count pass, prefix sum, then fill. Zones are visited in order so each cell list stays ascending.
+    const int32 NumCells = CellsX * CellsY;
+    CellStart.SetNumZeroed(NumCells + 1);
+
+    for (int32 ZoneIndex = 0; ZoneIndex < NumZones; ZoneIndex++)
+    {
+        ForEachCoveredCell(ZoneIndex, [this](int32 Cell) { CellStart[Cell + 1]++; });
+    }
+
+    for (int32 Cell = 0; Cell < NumCells; Cell++)
+    {
+        CellStart[Cell + 1] += CellStart[Cell];
+    }
+
+    CellZones.SetNumUninitialized(CellStart[NumCells]);
+    TArray<int32> WriteCursor(CellStart.GetData(), NumCells);
+
+    for (int32 ZoneIndex = 0; ZoneIndex < NumZones; ZoneIndex++)
+    {
+        ForEachCoveredCell(ZoneIndex, [this, &WriteCursor, ZoneIndex](int32 Cell) { CellZones[WriteCursor[Cell]++] = ZoneIndex; });
+    }
+}
+
+bool FSurvivalBiomeZoneIndex::GetCellCoords(double X, double Y, int32& OutCellX, int32& OutCellY) const
+{
+    const int32 RawX = FMath::FloorToInt32((X - GridOrigin.X) * InvCellSize);
+    const int32 RawY = FMath::FloorToInt32((Y - GridOrigin.Y) * InvCellSize);
+
+    OutCellX = FMath::Clamp(RawX, 0, CellsX - 1);
+    OutCellY = FMath::Clamp(RawY, 0, CellsY - 1);
+
+    return RawX == OutCellX && RawY == OutCellY;
+}
+
+TConstArrayView<int32> FSurvivalBiomeZoneIndex::GetCandidatesAtLocation(double X, double Y) const
+{
+    int32 CellX, CellY;
+    if (IsEmpty() || !GetCellCoords(X, Y, CellX, CellY))
+    {
+        // The grid covers every zone's bounding box, so nothing outside it can be inside a zone
+        return TConstArrayView<int32>();
+    }
+
+    const int32 Cell = CellY * CellsX + CellX;
+    return TConstArrayView<int32>(CellZones.GetData() + CellStart[Cell], CellStart[Cell + 1] - CellStart[Cell]);
+}
+
+void FSurvivalBiomeZoneIndex::GatherZonesOverlappingRect(const FBox2D& WorldRect, TArray<int32>& OutZoneIndices) const
+{
+    using namespace SurvivalBiomeZoneIndexConstants;
+
+    if (IsEmpty())
+    {
+        return;
+    }
+
+    const FBox2D PaddedRect = WorldRect.ExpandBy(RectQueryPadding);
+    int32 MinCellX, MinCellY, MaxCellX, MaxCellY;
+    GetCellCoords(PaddedRect.Min.X, PaddedRect.Min.Y, MinCellX, MinCellY);
+    GetCellCoords(PaddedRect.Max.X, PaddedRect.Max.Y, MaxCellX, MaxCellY);
+
+    const int32 FirstNew = OutZoneIndices.Num();
+
+    for (int32 CellY = MinCellY; CellY <= MaxCellY; CellY++)
+    {
+        for (int32 CellX = MinCellX; CellX <= MaxCellX; CellX++)
+        {
+            const int32 Cell = CellY * CellsX + CellX;
+            for (int32 Slot = CellStart[Cell]; Slot < CellStart[Cell + 1]; Slot++)
+            {
+                const int32 ZoneIndex = CellZones[Slot];
+                const FVector2D Center(CenterX[ZoneIndex], CenterY[ZoneIndex]);
+                const double Reach = Radius[ZoneIndex] + RectQueryPadding;
+
+                if (FVector2D::DistSquared(Center, WorldRect.GetClosestPointTo(Center)) < Reach * Reach)
+                {
+                    OutZoneIndices.Add(ZoneIndex);
+                }
+            }
+        }
+    }
+
+    // Zones spanning several cells are reported once each, in ascending order so blending order matches a full scan
+    TArrayView<int32> NewEntries(OutZoneIndices.GetData() + FirstNew, OutZoneIndices.Num() - FirstNew);
+    NewEntries.Sort();
+
+    int32 WriteIndex = FirstNew;
+    for (int32 ReadIndex = FirstNew; ReadIndex < OutZoneIndices.Num(); ReadIndex++)
+    {
+        if (WriteIndex == FirstNew || OutZoneIndices[WriteIndex - 1] != OutZoneIndices[ReadIndex])
+        {
+            OutZoneIndices[WriteIndex++] = OutZoneIndices[ReadIndex];
+        }
+    }
+    OutZoneIndices.SetNum(WriteIndex, EAllowShrinking::No);
+}
\ No newline at end of file
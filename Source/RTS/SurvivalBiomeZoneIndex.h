@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FBiomeZone;
+enum class EBiomeType : uint8;
+
+// Uniform grid over the biome zone circles. Zone data is kept as structure-of-arrays so
+// per-texel loops only touch the fields they need, and each grid cell lists (in ascending
+// order) the zones whose bounding box overlaps it.
+class RTS_API FSurvivalBiomeZoneIndex
+{
+public:
+    FSurvivalBiomeZoneIndex();
+
+    void Build(const TArray<FBiomeZone>& Zones);
+    void Reset();
+
+    int32 Num() const { return Radius.Num(); }
+    bool IsEmpty() const { return Radius.Num() == 0; }
+
+    // Zones that may contain the location, ascending by zone index. Empty outside the grid.
+    TConstArrayView<int32> GetCandidatesAtLocation(double X, double Y) const;
+
+    // Appends (ascending, no duplicates) every zone whose radius may reach into WorldRect.
+    // The test is padded so callers culling with it never lose a zone the full scan would see.
+    void GatherZonesOverlappingRect(const FBox2D& WorldRect, TArray<int32>& OutZoneIndices) const;
+
+    // Smooth-stepped falloff from zone center (1) to edge (0)
+    FORCEINLINE float GetInfluence(int32 ZoneIndex, double X, double Y) const
+    {
+        const double DX = X - CenterX[ZoneIndex];
+        const double DY = Y - CenterY[ZoneIndex];
+        const float Distance = FMath::Sqrt(DX * DX + DY * DY);
+        const float ZoneRadius = Radius[ZoneIndex];
+
+        if (Distance >= ZoneRadius)
+        {
+            return 0.0f;
+        }
+
+        return FMath::SmoothStep(0.0f, 1.0f, 1.0f - (Distance / ZoneRadius));
+    }
+
+    EBiomeType GetBiomeType(int32 ZoneIndex) const { return BiomeTypes[ZoneIndex]; }
+
+    const TArray<double>& GetCentersX() const { return CenterX; }
+    const TArray<double>& GetCentersY() const { return CenterY; }
+    const TArray<float>& GetRadii() const { return Radius; }
+    const TArray<EBiomeType>& GetBiomeTypes() const { return BiomeTypes; }
+
+private:
+    bool GetCellCoords(double X, double Y, int32& OutCellX, int32& OutCellY) const;
+
+    // Zone SoA, parallel to ASurvivalBiomeManager::BiomeZones
+    TArray<double> CenterX;
+    TArray<double> CenterY;
+    TArray<float> Radius;
+    TArray<EBiomeType> BiomeTypes;
+
+    // Grid in compressed-row form: zones of cell C are CellZones[CellStart[C] .. CellStart[C + 1])
+    FVector2D GridOrigin;
+    double CellSize;
+    double InvCellSize;
+    int32 CellsX;
+    int32 CellsY;
+    TArray<int32> CellStart;
+    TArray<int32> CellZones;
+};
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "SurvivalTetherComponent.h"
 #include "SurvivalMovementComponent.h"
 #include "SurvivalPlayerState.h"
+#include "SurvivalActorRegistry.h"
 #include "Net/UnrealNetwork.h"
 #include "Engine/Engine.h"
 
@@ -49,6 +50,22 @@ void ASurvivalCharacter::BeginPlay()
 {
     Super::BeginPlay();
     UpdateMovementSpeed();
+    
+    // Challenges and other proximity checks find characters through the registry's spatial hash
+    if (USurvivalActorRegistry* Registry = USurvivalActorRegistry::Get(this))
+    {
+        Registry->RegisterCharacter(this);
+    }
+}
+
+void ASurvivalCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (USurvivalActorRegistry* Registry = USurvivalActorRegistry::Get(this))
+    {
+        Registry->UnregisterCharacter(this);
+    }
+    
+    Super::EndPlay(EndPlayReason);
 }
 
 void ASurvivalCharacter::Tick(float DeltaTime)
@@ -0,0 +1,399 @@
+#include "SurvivalCompressedTerrainGrid.h"
+#include "Misc/Compression.h"
+#include "Serialization/Archive.h"
+
+namespace SurvivalCompressedTerrainGridFormat
+{
+    // Bump when the tile encoding changes
+    constexpr int32 FormatVersion = 1;
+
+    // Small residuals of either sign become small unsigned values, so the high byte plane is mostly zero
+    inline uint16 ZigZag16(uint16 Residual) { return uint16((Residual << 1) ^ (int16(Residual) >> 15)); }
+    inline uint16 UnZigZag16(uint16 Folded) { return uint16((Folded >> 1) ^ uint16(-int16(Folded & 1))); }
+    inline uint8 ZigZag8(uint8 Residual) { return uint8((Residual << 1) ^ (int8(Residual) >> 7)); }
+    inline uint8 UnZigZag8(uint8 Folded) { return uint8((Folded >> 1) ^ uint8(-int8(Folded & 1))); }
+
+    // Previous value in the tile's row order: left neighbour, or the one above at the start of a row
+    template <typename T>
+    inline T Predict(const T* Tile, int32 TileWidth, int32 X, int32 Y)
+    {
+        if (X > 0)
+        {
+            return Tile[Y * TileWidth + X - 1];
+        }
+        return Y > 0 ? Tile[(Y - 1) * TileWidth] : T(0);
+    }
+}
+
+FSurvivalCompressedTerrainGrid::FSurvivalCompressedTerrainGrid()
+    : Width(0)
+    , Height(0)
+    , TileSize(DefaultTileSize)
+    , BytesPerValue(sizeof(uint16))
+    , NumTilesX(0)
+    , NumTilesY(0)
+    , DecodedTiles(MakeUnique<FDecodedTileCache>(DefaultCachedTiles))
+{
+}
+
+FSurvivalCompressedTerrainGrid::FSurvivalCompressedTerrainGrid(const FSurvivalCompressedTerrainGrid& Other)
+    : Width(Other.Width)
+    , Height(Other.Height)
+    , TileSize(Other.TileSize)
+    , BytesPerValue(Other.BytesPerValue)
+    , NumTilesX(Other.NumTilesX)
+    , NumTilesY(Other.NumTilesY)
+    , Tiles(Other.Tiles)
+    , Payload(Other.Payload)
+    , DecodedTiles(MakeUnique<FDecodedTileCache>(Other.DecodedTiles->Tiles.Max()))
+{
+}
+
+FSurvivalCompressedTerrainGrid& FSurvivalCompressedTerrainGrid::operator=(const FSurvivalCompressedTerrainGrid& Other)
+{
+    if (this != &Other)
+    {
+        Width = Other.Width;
+        Height = Other.Height;
+        TileSize = Other.TileSize;
+        BytesPerValue = Other.BytesPerValue;
+        NumTilesX = Other.NumTilesX;
+        NumTilesY = Other.NumTilesY;
+        Tiles = Other.Tiles;
+        Payload = Other.Payload;
+        SetCacheCapacity(Other.DecodedTiles->Tiles.Max());
+    }
+    return *this;
+}
+
+void FSurvivalCompressedTerrainGrid::Compress(const TArray<uint16>& Values, int32 InWidth, int32 InHeight, int32 InTileSize)
+{
+    check(Values.Num() == InWidth * InHeight);
+    CompressValues(reinterpret_cast<const uint8*>(Values.GetData()), sizeof(uint16), InWidth, InHeight, InTileSize);
+}
+
+void FSurvivalCompressedTerrainGrid::Compress(const TArray<uint8>& Values, int32 InWidth, int32 InHeight, int32 InTileSize)
+{
+    check(Values.Num() == InWidth * InHeight);
+    CompressValues(Values.GetData(), sizeof(uint8), InWidth, InHeight, InTileSize);
+}
+
+void FSurvivalCompressedTerrainGrid::Reset()
+{
+    Width = 0;
+    Height = 0;
+    NumTilesX = 0;
+    NumTilesY = 0;
+    Tiles.Empty();
+    Payload.Empty();
+    SetCacheCapacity(DecodedTiles->Tiles.Max());
+}
+
+void FSurvivalCompressedTerrainGrid::CompressValues(const uint8* Values, int32 InBytesPerValue, int32 InWidth, int32 InHeight, int32 InTileSize)
+{
+    using namespace SurvivalCompressedTerrainGridFormat;
+
+    Reset();
+
+    if (InWidth <= 0 || InHeight <= 0)
+    {
+        return;
+    }
+
+    Width = InWidth;
+    Height = InHeight;
+    TileSize = FMath::Max(InTileSize, 1);
+    BytesPerValue = InBytesPerValue;
+    NumTilesX = FMath::DivideAndRoundUp(Width, TileSize);
+    NumTilesY = FMath::DivideAndRoundUp(Height, TileSize);
+
+    TArray<uint8> TileValues;
+    TArray<uint8> Residuals;
+    TArray<uint8> Compressed;
+
+    for (int32 TileY = 0; TileY < NumTilesY; TileY++)
+    {
+        for (int32 TileX = 0; TileX < NumTilesX; TileX++)
+        {
+            int32 TileWidth, TileHeight;
+            GetTileExtent(TileX, TileY, TileWidth, TileHeight);
+            const int32 NumValues = TileWidth * TileHeight;
+            const int32 RawSize = NumValues * BytesPerValue;
+
+            // Gather the tile so prediction never reads across tile borders
+            TileValues.SetNumUninitialized(RawSize, EAllowShrinking::No);
+            for (int32 Y = 0; Y < TileHeight; Y++)
+            {
+                const int64 SourceOffset = (int64(TileY * TileSize + Y) * Width + TileX * TileSize) * BytesPerValue;
+                FMemory::Memcpy(TileValues.GetData() + Y * TileWidth * BytesPerValue, Values + SourceOffset, TileWidth * BytesPerValue);
+            }
+
+            Residuals.SetNumUninitialized(RawSize, EAllowShrinking::No);
+            if (BytesPerValue == sizeof(uint16))
+            {
+                // Low bytes of every residual, then the high bytes
+                const uint16* Tile = reinterpret_cast<const uint16*>(TileValues.GetData());
+                for (int32 Y = 0; Y < TileHeight; Y++)
+                {
+                    for (int32 X = 0; X < TileWidth; X++)
+                    {
+                        const int32 Index = Y * TileWidth + X;
+                        const uint16 Folded = ZigZag16(uint16(Tile[Index] - Predict(Tile, TileWidth, X, Y)));
+                        Residuals[Index] = uint8(Folded & 0xFF);
+                        Residuals[NumValues + Index] = uint8(Folded >> 8);
+                    }
+                }
+            }
+            else
+            {
+                const uint8* Tile = TileValues.GetData();
+                for (int32 Y = 0; Y < TileHeight; Y++)
+                {
+                    for (int32 X = 0; X < TileWidth; X++)
+                    {
+                        const int32 Index = Y * TileWidth + X;
+                        Residuals[Index] = ZigZag8(uint8(Tile[Index] - Predict(Tile, TileWidth, X, Y)));
+                    }
+                }
+            }
+
+            int32 CompressedSize = FCompression::CompressMemoryBound(NAME_LZ4, RawSize);
+            Compressed.SetNumUninitialized(CompressedSize, EAllowShrinking::No);
+
+            FTileEntry& Entry = Tiles.AddDefaulted_GetRef();
+            Entry.Offset = uint32(Payload.Num());
+
+            if (FCompression::CompressMemory(NAME_LZ4, Compressed.GetData(), CompressedSize, Residuals.GetData(), RawSize) && CompressedSize < RawSize)
+            {
+                Entry.CompressedSize = uint32(CompressedSize);
+                Payload.Append(Compressed.GetData(), CompressedSize);
+            }
+            else
+            {
+                // Noise-like tiles can grow under LZ4; keep the residuals as they are
+                Entry.CompressedSize = uint32(RawSize);
+                Payload.Append(Residuals.GetData(), RawSize);
+            }
+        }
+    }
+
+    Payload.Shrink();
+}
+
+void FSurvivalCompressedTerrainGrid::GetTileExtent(int32 TileX, int32 TileY, int32& OutTileWidth, int32& OutTileHeight) const
+{
+    OutTileWidth = FMath::Min(TileSize, Width - TileX * TileSize);
+    OutTileHeight = FMath::Min(TileSize, Height - TileY * TileSize);
+}
+
+bool FSurvivalCompressedTerrainGrid::DecodeTile(int32 TileIndex, TArray<uint8>& OutTile) const
+{
+    using namespace SurvivalCompressedTerrainGridFormat;
+
+    int32 TileWidth, TileHeight;
+    GetTileExtent(TileIndex % NumTilesX, TileIndex / NumTilesX, TileWidth, TileHeight);
+    const int32 NumValues = TileWidth * TileHeight;
+    const int32 RawSize = NumValues * BytesPerValue;
+
+    const FTileEntry& Entry = Tiles[TileIndex];
+    if (int64(Entry.Offset) + Entry.CompressedSize > Payload.Num())
+    {
+        return false;
+    }
+
+    TArray<uint8> Residuals;
+    Residuals.SetNumUninitialized(RawSize);
+    const uint8* Source = Payload.GetData() + Entry.Offset;
+    if (int32(Entry.CompressedSize) == RawSize)
+    {
+        FMemory::Memcpy(Residuals.GetData(), Source, RawSize);
+    }
+    else if (!FCompression::UncompressMemory(NAME_LZ4, Residuals.GetData(), RawSize, Source, Entry.CompressedSize))
+    {
+        return false;
+    }
+
+    OutTile.SetNumUninitialized(RawSize);
+    if (BytesPerValue == sizeof(uint16))
+    {
+        uint16* Tile = reinterpret_cast<uint16*>(OutTile.GetData());
+        for (int32 Y = 0; Y < TileHeight; Y++)
+        {
+            for (int32 X = 0; X < TileWidth; X++)
+            {
+                const int32 Index = Y * TileWidth + X;
+                const uint16 Folded = uint16(Residuals[Index] | (Residuals[NumValues + Index] << 8));
+                Tile[Index] = uint16(Predict(Tile, TileWidth, X, Y) + UnZigZag16(Folded));
+            }
+        }
+    }
+    else
+    {
+        uint8* Tile = OutTile.GetData();
+        for (int32 Y = 0; Y < TileHeight; Y++)
+        {
+            for (int32 X = 0; X < TileWidth; X++)
+            {
+                const int32 Index = Y * TileWidth + X;
+                Tile[Index] = uint8(Predict(Tile, TileWidth, X, Y) + UnZigZag8(Residuals[Index]));
+            }
+        }
+    }
+
+    return true;
+}
+
+TSharedPtr<const TArray<uint8>> FSurvivalCompressedTerrainGrid::GetTile(int32 TileX, int32 TileY) const
+{
+    if (TileX < 0 || TileY < 0 || TileX >= NumTilesX || TileY >= NumTilesY)
+    {
+        return nullptr;
+    }
+
+    const int32 TileIndex = TileY * NumTilesX + TileX;
+    {
+        FScopeLock Lock(&DecodedTiles->Mutex);
+        if (const TSharedPtr<const TArray<uint8>>* Cached = DecodedTiles->Tiles.FindAndTouch(TileIndex))
+        {
+            return *Cached;
+        }
+    }
+
+    // Decode outside the lock; two threads missing on the same tile both decode it, which is harmless
+    TSharedPtr<TArray<uint8>> Decoded = MakeShared<TArray<uint8>>();
+    if (!DecodeTile(TileIndex, *Decoded))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Compressed terrain grid: tile %d,%d failed to decode"), TileX, TileY);
+        return nullptr;
+    }
+
+    FScopeLock Lock(&DecodedTiles->Mutex);
+    DecodedTiles->Tiles.Add(TileIndex, Decoded);
+    return Decoded;
+}
+
+uint16 FSurvivalCompressedTerrainGrid::GetValue(int32 X, int32 Y) const
+{
+    if (X < 0 || Y < 0 || X >= Width || Y >= Height)
+    {
+        return 0;
+    }
+
+    const TSharedPtr<const TArray<uint8>> Tile = GetTile(X / TileSize, Y / TileSize);
+    if (!Tile.IsValid())
+    {
+        return 0;
+    }
+
+    int32 TileWidth, TileHeight;
+    GetTileExtent(X / TileSize, Y / TileSize, TileWidth, TileHeight);
+    const int32 Index = (Y % TileSize) * TileWidth + X % TileSize;
+
+    return BytesPerValue == sizeof(uint16) ? reinterpret_cast<const uint16*>(Tile->GetData())[Index] : (*Tile)[Index];
+}
+
+bool FSurvivalCompressedTerrainGrid::Decompress(TArray<uint16>& OutValues) const
+{
+    OutValues.SetNumUninitialized(Width * Height);
+    if (!DecompressValues(sizeof(uint16), reinterpret_cast<uint8*>(OutValues.GetData())))
+    {
+        OutValues.Reset();
+        return false;
+    }
+    return true;
+}
+
+bool FSurvivalCompressedTerrainGrid::Decompress(TArray<uint8>& OutValues) const
+{
+    OutValues.SetNumUninitialized(Width * Height);
+    if (!DecompressValues(sizeof(uint8), OutValues.GetData()))
+    {
+        OutValues.Reset();
+        return false;
+    }
+    return true;
+}
+
+bool FSurvivalCompressedTerrainGrid::DecompressValues(int32 ExpectedBytesPerValue, uint8* OutValues) const
+{
+    if (!IsValid() || BytesPerValue != ExpectedBytesPerValue)
+    {
+        return false;
+    }
+
+    // Full decodes bypass the cache so they don't evict the tiles point lookups are using
+    TArray<uint8> Tile;
+    for (int32 TileY = 0; TileY < NumTilesY; TileY++)
+    {
+        for (int32 TileX = 0; TileX < NumTilesX; TileX++)
+        {
+            if (!DecodeTile(TileY * NumTilesX + TileX, Tile))
+            {
+                return false;
+            }
+
+            int32 TileWidth, TileHeight;
+            GetTileExtent(TileX, TileY, TileWidth, TileHeight);
+            for (int32 Y = 0; Y < TileHeight; Y++)
+            {
+                const int64 DestOffset = (int64(TileY * TileSize + Y) * Width + TileX * TileSize) * BytesPerValue;
+                FMemory::Memcpy(OutValues + DestOffset, Tile.GetData() + Y * TileWidth * BytesPerValue, TileWidth * BytesPerValue);
+            }
+        }
+    }
+
+    return true;
+}
+
+void FSurvivalCompressedTerrainGrid::SetCacheCapacity(int32 NumTiles)
+{
+    FScopeLock Lock(&DecodedTiles->Mutex);
+    DecodedTiles->Tiles.Empty(FMath::Max(NumTiles, 1));
+}
+
+void FSurvivalCompressedTerrainGrid::Serialize(FArchive& Ar)
+{
+    using namespace SurvivalCompressedTerrainGridFormat;
+
+    int32 Version = FormatVersion;
+    Ar << Version;
+    if (Ar.IsLoading() && Version != FormatVersion)
+    {
+        Ar.SetError();
+        return;
+    }
+
+    Ar << Width << Height << TileSize << BytesPerValue;
+
+    int32 NumTiles = Tiles.Num();
+    Ar << NumTiles;
+
+    if (Ar.IsLoading())
+    {
+        const bool bValidLayout = Width > 0 && Height > 0 && TileSize > 0 && (BytesPerValue == sizeof(uint8) || BytesPerValue == sizeof(uint16))
+            && NumTiles == FMath::DivideAndRoundUp(Width, TileSize) * FMath::DivideAndRoundUp(Height, TileSize);
+        if (!bValidLayout)
+        {
+            Ar.SetError();
+            Reset();
+            return;
+        }
+
+        NumTilesX = FMath::DivideAndRoundUp(Width, TileSize);
+        NumTilesY = FMath::DivideAndRoundUp(Height, TileSize);
+        Tiles.SetNumUninitialized(NumTiles);
+        SetCacheCapacity(DecodedTiles->Tiles.Max());
+    }
+
+    for (FTileEntry& Entry : Tiles)
+    {
+        Ar << Entry.Offset << Entry.CompressedSize;
+    }
+
+    Ar << Payload;
+
+    if (Ar.IsLoading() && Ar.IsError())
+    {
+        Reset();
+    }
+}
\ No newline at end of file
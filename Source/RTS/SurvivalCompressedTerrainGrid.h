@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LruCache.h"
+
+// A Width x Height grid of 8- or 16-bit terrain values (heights, weight layers) held compressed in
+// square tiles. Each tile is delta coded against its left (or upper) neighbour, zigzag folded and
+// split into byte planes, then LZ4 compressed, so single tiles decompress independently. Recently
+// decoded tiles are kept in a small LRU cache; lookups are safe from any thread.
+class RTS_API FSurvivalCompressedTerrainGrid
+{
+public:
+    static constexpr int32 DefaultTileSize = 64;
+    static constexpr int32 DefaultCachedTiles = 16;
+
+    FSurvivalCompressedTerrainGrid();
+    FSurvivalCompressedTerrainGrid(const FSurvivalCompressedTerrainGrid& Other);
+    FSurvivalCompressedTerrainGrid& operator=(const FSurvivalCompressedTerrainGrid& Other);
+
+    void Compress(const TArray<uint16>& Values, int32 InWidth, int32 InHeight, int32 InTileSize = DefaultTileSize);
+    void Compress(const TArray<uint8>& Values, int32 InWidth, int32 InHeight, int32 InTileSize = DefaultTileSize);
+    void Reset();
+
+    bool IsValid() const { return Width > 0 && Height > 0; }
+
+    int32 GetWidth() const { return Width; }
+    int32 GetHeight() const { return Height; }
+    int32 GetTileSize() const { return TileSize; }
+    int32 GetBytesPerValue() const { return BytesPerValue; }
+    int32 GetNumTilesX() const { return NumTilesX; }
+    int32 GetNumTilesY() const { return NumTilesY; }
+
+    // Size of the compressed tiles, for memory and bandwidth reporting
+    int64 GetCompressedSize() const { return Payload.Num(); }
+    int64 GetUncompressedSize() const { return int64(Width) * Height * BytesPerValue; }
+
+    // Decoded tile values row by row (tile width x tile height, narrower at the right and bottom edges),
+    // in the grid's value type. Shared with the cache, so it stays valid after eviction. Null when out of range.
+    TSharedPtr<const TArray<uint8>> GetTile(int32 TileX, int32 TileY) const;
+
+    // Single value through the tile cache; 0 outside the grid
+    uint16 GetValue(int32 X, int32 Y) const;
+
+    // Whole grid; false when the value type does not match or a tile fails to decode
+    bool Decompress(TArray<uint16>& OutValues) const;
+    bool Decompress(TArray<uint8>& OutValues) const;
+
+    void SetCacheCapacity(int32 NumTiles);
+
+    // Compressed form only, for the disk cache and for sending courses to clients
+    void Serialize(FArchive& Ar);
+
+private:
+    struct FTileEntry
+    {
+        // Byte offset into Payload; a tile stored uncompressed has CompressedSize equal to its raw size
+        uint32 Offset;
+        uint32 CompressedSize;
+    };
+
+    void CompressValues(const uint8* Values, int32 InBytesPerValue, int32 InWidth, int32 InHeight, int32 InTileSize);
+    bool DecompressValues(int32 ExpectedBytesPerValue, uint8* OutValues) const;
+    bool DecodeTile(int32 TileIndex, TArray<uint8>& OutTile) const;
+    void GetTileExtent(int32 TileX, int32 TileY, int32& OutTileWidth, int32& OutTileHeight) const;
+
+    int32 Width;
+    int32 Height;
+    int32 TileSize;
+    int32 BytesPerValue;
+    int32 NumTilesX;
+    int32 NumTilesY;
+
+    TArray<FTileEntry> Tiles;
+    TArray<uint8> Payload;
+
+    // Not copied with the grid; each copy warms its own cache
+    struct FDecodedTileCache
+    {
+        FDecodedTileCache(int32 NumTiles) : Tiles(NumTiles) {}
+
+        FCriticalSection Mutex;
+        TLruCache<int32, TSharedPtr<const TArray<uint8>>> Tiles;
+    };
+    TUniquePtr<FDecodedTileCache> DecodedTiles;
+};
\ No newline at end of file
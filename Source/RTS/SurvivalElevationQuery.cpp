@@ -0,0 +1,166 @@
+#include "SurvivalElevationQuery.h"
+
+FSurvivalElevationQuery::FSurvivalElevationQuery()
+    : Width(0)
+    , Height(0)
+    , WorldToTexelX(0.0f)
+    , WorldToTexelY(0.0f)
+    , HeightScale(0.0f)
+{
+}
+
+void FSurvivalElevationQuery::SetHeightmap(const TArray<uint16>& InHeightValues, int32 InWidth, int32 InHeight, const FVector2D& InWorldExtent, float InMaxElevation)
+{
+    SetHeightmap(TArray<uint16>(InHeightValues), InWidth, InHeight, InWorldExtent, InMaxElevation);
+}
+
+void FSurvivalElevationQuery::SetHeightmap(TArray<uint16>&& InHeightValues, int32 InWidth, int32 InHeight, const FVector2D& InWorldExtent, float InMaxElevation)
+{
+    if (InWidth < 2 || InHeight < 2 || InHeightValues.Num() != InWidth * InHeight || InWorldExtent.X <= 0.0 || InWorldExtent.Y <= 0.0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Elevation query: rejected %dx%d heightmap with %d values"), InWidth, InHeight, InHeightValues.Num());
+        Reset();
+        return;
+    }
+
+    HeightValues = MoveTemp(InHeightValues);
+    Width = InWidth;
+    Height = InHeight;
+    WorldToTexelX = float((InWidth - 1) / InWorldExtent.X);
+    WorldToTexelY = float((InHeight - 1) / InWorldExtent.Y);
+    HeightScale = InMaxElevation / 65535.0f;
+    Pyramid.Build(HeightValues, Width, Height);
+}
+
+void FSurvivalElevationQuery::Reset()
+{
+    HeightValues.Empty();
+    Width = 0;
+    Height = 0;
+    Pyramid.Reset();
+}
+
+float FSurvivalElevationQuery::Sample(float WorldX, float WorldY, ESurvivalElevationFilter Filter) const
+{
+    if (!IsValid())
+    {
+        return 0.0f;
+    }
+
+    return SampleTexel(WorldX * WorldToTexelX, WorldY * WorldToTexelY, Filter);
+}
+
+float FSurvivalElevationQuery::SampleUV(float U, float V, ESurvivalElevationFilter Filter) const
+{
+    if (!IsValid())
+    {
+        return 0.0f;
+    }
+
+    return SampleTexel(U * (Width - 1), V * (Height - 1), Filter);
+}
+
+void FSurvivalElevationQuery::SampleBatch(TArrayView<const FVector> WorldLocations, TArrayView<float> OutElevations, ESurvivalElevationFilter Filter) const
+{
+    check(WorldLocations.Num() == OutElevations.Num());
+
+    if (!IsValid())
+    {
+        for (float& Elevation : OutElevations)
+        {
+            Elevation = 0.0f;
+        }
+        return;
+    }
+
+    for (int32 Index = 0; Index < WorldLocations.Num(); Index++)
+    {
+        OutElevations[Index] = SampleTexel(WorldLocations[Index].X * WorldToTexelX, WorldLocations[Index].Y * WorldToTexelY, Filter);
+    }
+}
+
+bool FSurvivalElevationQuery::RayCast(const FVector& Start, const FVector& End, FVector& OutHitLocation) const
+{
+    if (!IsValid() || HeightScale <= 0.0f)
+    {
+        return false;
+    }
+
+    const FVector WorldToTexel(WorldToTexelX, WorldToTexelY, 1.0f / HeightScale);
+    float HitTime;
+    if (!Pyramid.RayMarch(HeightValues, Start * WorldToTexel, End * WorldToTexel, HitTime))
+    {
+        return false;
+    }
+
+    OutHitLocation = FMath::Lerp(Start, End, HitTime);
+    return true;
+}
+
+bool FSurvivalElevationQuery::HasLineOfSight(const FVector& From, const FVector& To) const
+{
+    FVector HitLocation;
+    return !RayCast(From, To, HitLocation);
+}
+
+float FSurvivalElevationQuery::SampleTexel(float TexelX, float TexelY, ESurvivalElevationFilter Filter) const
+{
+    if (Filter == ESurvivalElevationFilter::Bicubic)
+    {
+        return SampleBicubic(TexelX, TexelY) * HeightScale;
+    }
+
+    return SampleHeightValueBilinear(HeightValues.GetData(), Width, Height, TexelX, TexelY) * HeightScale;
+}
+
+float FSurvivalElevationQuery::SampleHeightValueBilinear(const uint16* InHeightValues, int32 InWidth, int32 InHeight, float TexelX, float TexelY)
+{
+    TexelX = FMath::Clamp(TexelX, 0.0f, float(InWidth - 1));
+    TexelY = FMath::Clamp(TexelY, 0.0f, float(InHeight - 1));
+
+    // The last row and column interpolate toward themselves
+    const int32 X0 = FMath::Min(FMath::FloorToInt(TexelX), InWidth - 2);
+    const int32 Y0 = FMath::Min(FMath::FloorToInt(TexelY), InHeight - 2);
+    const float FracX = TexelX - X0;
+    const float FracY = TexelY - Y0;
+
+    const uint16* Row0 = InHeightValues + Y0 * InWidth + X0;
+    const uint16* Row1 = Row0 + InWidth;
+
+    const float Top = FMath::Lerp(float(Row0[0]), float(Row0[1]), FracX);
+    const float Bottom = FMath::Lerp(float(Row1[0]), float(Row1[1]), FracX);
+    return FMath::Lerp(Top, Bottom, FracY);
+}
+
+float FSurvivalElevationQuery::SampleBicubic(float TexelX, float TexelY) const
+{
+    TexelX = FMath::Clamp(TexelX, 0.0f, float(Width - 1));
+    TexelY = FMath::Clamp(TexelY, 0.0f, float(Height - 1));
+
+    const int32 X1 = FMath::Min(FMath::FloorToInt(TexelX), Width - 2);
+    const int32 Y1 = FMath::Min(FMath::FloorToInt(TexelY), Height - 2);
+    const float FracX = TexelX - X1;
+    const float FracY = TexelY - Y1;
+
+    // Catmull-Rom through texels 0-3 with the sample between 1 and 2; edge texels are repeated
+    auto CatmullRom = [](float P0, float P1, float P2, float P3, float T)
+    {
+        return P1 + 0.5f * T * (P2 - P0 + T * (2.0f * P0 - 5.0f * P1 + 4.0f * P2 - P3 + T * (3.0f * (P1 - P2) + P3 - P0)));
+    };
+
+    int32 Columns[4];
+    for (int32 Tap = 0; Tap < 4; Tap++)
+    {
+        Columns[Tap] = FMath::Clamp(X1 - 1 + Tap, 0, Width - 1);
+    }
+
+    float RowValues[4];
+    for (int32 Tap = 0; Tap < 4; Tap++)
+    {
+        const uint16* Row = HeightValues.GetData() + FMath::Clamp(Y1 - 1 + Tap, 0, Height - 1) * Width;
+        RowValues[Tap] = CatmullRom(Row[Columns[0]], Row[Columns[1]], Row[Columns[2]], Row[Columns[3]], FracX);
+    }
+
+    // Catmull-Rom can overshoot between steep texels
+    return FMath::Clamp(CatmullRom(RowValues[0], RowValues[1], RowValues[2], RowValues[3], FracY), 0.0f, 65535.0f);
+}
\ No newline at end of file
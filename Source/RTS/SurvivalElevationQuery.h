@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SurvivalHeightfieldPyramid.h"
+
+enum class ESurvivalElevationFilter : uint8
+{
+    Bilinear,
+    // Catmull-Rom over the 4x4 texel neighbourhood; smooth first derivative, for splines and profiles
+    Bicubic
+};
+
+// Constant-time elevation lookups into a generated heightmap. Owns the 0-65535 height values (half the
+// size of a float buffer) laid out Width x Height over [0, WorldExtent]; locations outside the course
+// are clamped to its edge.
+class RTS_API FSurvivalElevationQuery
+{
+public:
+    FSurvivalElevationQuery();
+
+    void SetHeightmap(const TArray<uint16>& InHeightValues, int32 InWidth, int32 InHeight, const FVector2D& InWorldExtent, float InMaxElevation);
+    // Takes the heights over instead of copying them, for owners that keep no other copy
+    void SetHeightmap(TArray<uint16>&& InHeightValues, int32 InWidth, int32 InHeight, const FVector2D& InWorldExtent, float InMaxElevation);
+    void Reset();
+
+    bool IsValid() const { return Width >= 2 && Height >= 2; }
+
+    // The 0-65535 heights as set, row-major
+    const TArray<uint16>& GetHeightValues() const { return HeightValues; }
+    int32 GetWidth() const { return Width; }
+    int32 GetHeight() const { return Height; }
+
+    float Sample(float WorldX, float WorldY, ESurvivalElevationFilter Filter = ESurvivalElevationFilter::Bilinear) const;
+    float Sample(const FVector& WorldLocation, ESurvivalElevationFilter Filter = ESurvivalElevationFilter::Bilinear) const { return Sample(WorldLocation.X, WorldLocation.Y, Filter); }
+
+    // U and V in [0, 1] across the course
+    float SampleUV(float U, float V, ESurvivalElevationFilter Filter = ESurvivalElevationFilter::Bilinear) const;
+
+    // OutElevations must have one entry per location
+    void SampleBatch(TArrayView<const FVector> WorldLocations, TArrayView<float> OutElevations, ESurvivalElevationFilter Filter = ESurvivalElevationFilter::Bilinear) const;
+
+    // First point where the segment Start-End meets the bilinear terrain surface; parts of the segment
+    // outside the course never hit
+    bool RayCast(const FVector& Start, const FVector& End, FVector& OutHitLocation) const;
+
+    // True when the segment From-To stays above the terrain
+    bool HasLineOfSight(const FVector& From, const FVector& To) const;
+
+    // Bilinear lookup into any 0-65535 heightmap at fractional texel coordinates, in the same 0-65535 units
+    static float SampleHeightValueBilinear(const uint16* HeightValues, int32 InWidth, int32 InHeight, float TexelX, float TexelY);
+
+private:
+    float SampleTexel(float TexelX, float TexelY, ESurvivalElevationFilter Filter) const;
+    float SampleBicubic(float TexelX, float TexelY) const;
+
+    TArray<uint16> HeightValues;
+    int32 Width;
+    int32 Height;
+
+    // World units to texels, and 0-65535 to world height
+    float WorldToTexelX;
+    float WorldToTexelY;
+    float HeightScale;
+
+    FSurvivalHeightfieldPyramid Pyramid;
+};
\ No newline at end of file
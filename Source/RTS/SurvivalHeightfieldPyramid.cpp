@@ -0,0 +1,275 @@
+#include "SurvivalHeightfieldPyramid.h"
+
+namespace SurvivalHeightfieldPyramidConstants
+{
+    // Texels a cell lookup is pushed along the ray so a point on a cell boundary resolves to the cell being entered
+    constexpr double BoundaryNudge = 1e-3;
+}
+
+FSurvivalHeightfieldPyramid::FSurvivalHeightfieldPyramid()
+    : HeightfieldWidth(0)
+    , HeightfieldHeight(0)
+{
+}
+
+void FSurvivalHeightfieldPyramid::Build(const TArray<uint16>& HeightValues, int32 Width, int32 Height)
+{
+    Reset();
+
+    if (Width < 2 || Height < 2 || HeightValues.Num() != Width * Height)
+    {
+        return;
+    }
+
+    HeightfieldWidth = Width;
+    HeightfieldHeight = Height;
+
+    // Level 0: range of each quad's four corners
+    FLevel& Base = Levels.AddDefaulted_GetRef();
+    Base.Width = Width - 1;
+    Base.Height = Height - 1;
+    Base.Min.SetNumUninitialized(Base.Width * Base.Height);
+    Base.Max.SetNumUninitialized(Base.Width * Base.Height);
+
+    for (int32 QuadY = 0; QuadY < Base.Height; QuadY++)
+    {
+        const uint16* Row0 = HeightValues.GetData() + QuadY * Width;
+        const uint16* Row1 = Row0 + Width;
+        for (int32 QuadX = 0; QuadX < Base.Width; QuadX++)
+        {
+            const int32 Cell = QuadY * Base.Width + QuadX;
+            Base.Min[Cell] = FMath::Min(FMath::Min(Row0[QuadX], Row0[QuadX + 1]), FMath::Min(Row1[QuadX], Row1[QuadX + 1]));
+            Base.Max[Cell] = FMath::Max(FMath::Max(Row0[QuadX], Row0[QuadX + 1]), FMath::Max(Row1[QuadX], Row1[QuadX + 1]));
+        }
+    }
+
+    // Halve until a single cell covers the heightfield; odd edges fold into a narrower last cell
+    while (Levels.Last().Width > 1 || Levels.Last().Height > 1)
+    {
+        const int32 ChildIndex = Levels.Num() - 1;
+        FLevel& Parent = Levels.AddDefaulted_GetRef();
+        const FLevel& Child = Levels[ChildIndex];
+
+        Parent.Width = FMath::DivideAndRoundUp(Child.Width, 2);
+        Parent.Height = FMath::DivideAndRoundUp(Child.Height, 2);
+        Parent.Min.SetNumUninitialized(Parent.Width * Parent.Height);
+        Parent.Max.SetNumUninitialized(Parent.Width * Parent.Height);
+
+        for (int32 CellY = 0; CellY < Parent.Height; CellY++)
+        {
+            for (int32 CellX = 0; CellX < Parent.Width; CellX++)
+            {
+                uint16 MinValue = MAX_uint16;
+                uint16 MaxValue = 0;
+                for (int32 ChildY = CellY * 2; ChildY < FMath::Min(CellY * 2 + 2, Child.Height); ChildY++)
+                {
+                    for (int32 ChildX = CellX * 2; ChildX < FMath::Min(CellX * 2 + 2, Child.Width); ChildX++)
+                    {
+                        MinValue = FMath::Min(MinValue, Child.Min[ChildY * Child.Width + ChildX]);
+                        MaxValue = FMath::Max(MaxValue, Child.Max[ChildY * Child.Width + ChildX]);
+                    }
+                }
+                Parent.Min[CellY * Parent.Width + CellX] = MinValue;
+                Parent.Max[CellY * Parent.Width + CellX] = MaxValue;
+            }
+        }
+    }
+}
+
+void FSurvivalHeightfieldPyramid::Reset()
+{
+    Levels.Empty();
+    HeightfieldWidth = 0;
+    HeightfieldHeight = 0;
+}
+
+bool FSurvivalHeightfieldPyramid::RayMarch(const TArray<uint16>& HeightValues, const FVector& Start, const FVector& End, float& OutHitTime) const
+{
+    using namespace SurvivalHeightfieldPyramidConstants;
+
+    if (!IsValid())
+    {
+        return false;
+    }
+
+    const double QuadsX = HeightfieldWidth - 1;
+    const double QuadsY = HeightfieldHeight - 1;
+    const FVector Delta = End - Start;
+
+    // Clip the segment to the heightfield footprint
+    double EnterTime = 0.0;
+    double ExitTime = 1.0;
+    const double Origins[2] = { Start.X, Start.Y };
+    const double Directions[2] = { Delta.X, Delta.Y };
+    const double Extents[2] = { QuadsX, QuadsY };
+    for (int32 Axis = 0; Axis < 2; Axis++)
+    {
+        if (FMath::IsNearlyZero(Directions[Axis]))
+        {
+            if (Origins[Axis] < 0.0 || Origins[Axis] > Extents[Axis])
+            {
+                return false;
+            }
+            continue;
+        }
+
+        double AxisEnter = -Origins[Axis] / Directions[Axis];
+        double AxisExit = (Extents[Axis] - Origins[Axis]) / Directions[Axis];
+        if (AxisEnter > AxisExit)
+        {
+            Swap(AxisEnter, AxisExit);
+        }
+        EnterTime = FMath::Max(EnterTime, AxisEnter);
+        ExitTime = FMath::Min(ExitTime, AxisExit);
+    }
+
+    if (EnterTime > ExitTime)
+    {
+        return false;
+    }
+
+    const int32 TopLevel = Levels.Num() - 1;
+    int32 Level = TopLevel;
+    double Time = EnterTime;
+
+    // Each step either descends a level or moves past a cell, so this only guards against float stalls
+    const int32 MaxSteps = 4 * (HeightfieldWidth + HeightfieldHeight) * Levels.Num();
+    for (int32 Step = 0; Step < MaxSteps; Step++)
+    {
+        const FLevel& CurrentLevel = Levels[Level];
+        const double CellSize = double(1 << Level);
+
+        const double PointX = Start.X + Delta.X * Time + FMath::Sign(Delta.X) * BoundaryNudge;
+        const double PointY = Start.Y + Delta.Y * Time + FMath::Sign(Delta.Y) * BoundaryNudge;
+        const int32 CellX = FMath::Clamp(FMath::FloorToInt32(PointX / CellSize), 0, CurrentLevel.Width - 1);
+        const int32 CellY = FMath::Clamp(FMath::FloorToInt32(PointY / CellSize), 0, CurrentLevel.Height - 1);
+
+        // Where the segment leaves this cell
+        double CellExitTime = ExitTime;
+        if (Delta.X > 0.0)
+        {
+            CellExitTime = FMath::Min(CellExitTime, (FMath::Min((CellX + 1) * CellSize, QuadsX) - Start.X) / Delta.X);
+        }
+        else if (Delta.X < 0.0)
+        {
+            CellExitTime = FMath::Min(CellExitTime, (CellX * CellSize - Start.X) / Delta.X);
+        }
+        if (Delta.Y > 0.0)
+        {
+            CellExitTime = FMath::Min(CellExitTime, (FMath::Min((CellY + 1) * CellSize, QuadsY) - Start.Y) / Delta.Y);
+        }
+        else if (Delta.Y < 0.0)
+        {
+            CellExitTime = FMath::Min(CellExitTime, (CellY * CellSize - Start.Y) / Delta.Y);
+        }
+        CellExitTime = FMath::Max(CellExitTime, Time);
+
+        const double EnterZ = Start.Z + Delta.Z * Time;
+        const double ExitZ = Start.Z + Delta.Z * CellExitTime;
+        const int32 Cell = CellY * CurrentLevel.Width + CellX;
+
+        bool bAdvance = false;
+        if (FMath::Min(EnterZ, ExitZ) > CurrentLevel.Max[Cell])
+        {
+            // Above everything in this cell
+            bAdvance = true;
+        }
+        else if (FMath::Max(EnterZ, ExitZ) < CurrentLevel.Min[Cell])
+        {
+            // Below everything in this cell; everything before Time was above the surface, so it crosses here
+            OutHitTime = float(Time);
+            return true;
+        }
+        else if (Level > 0)
+        {
+            Level--;
+            continue;
+        }
+        else
+        {
+            float QuadHitTime;
+            if (IntersectQuad(HeightValues, HeightfieldWidth, CellX, CellY, Start, Delta, float(Time), float(CellExitTime), QuadHitTime))
+            {
+                OutHitTime = QuadHitTime;
+                return true;
+            }
+            bAdvance = true;
+        }
+
+        if (bAdvance)
+        {
+            if (CellExitTime >= ExitTime)
+            {
+                return false;
+            }
+            Time = CellExitTime;
+
+            // Cheap to climb back up: the next coarse cell is often empty too
+            Level = FMath::Min(Level + 1, TopLevel);
+        }
+    }
+
+    return false;
+}
+
+bool FSurvivalHeightfieldPyramid::IntersectQuad(const TArray<uint16>& HeightValues, int32 InHeightfieldWidth, int32 QuadX, int32 QuadY,
+                                                const FVector& Start, const FVector& Delta, float T0, float T1, float& OutHitTime)
+{
+    const uint16* Row0 = HeightValues.GetData() + QuadY * InHeightfieldWidth + QuadX;
+    const uint16* Row1 = Row0 + InHeightfieldWidth;
+
+    // Bilinear surface h(U, V) = A + B U + C V + D U V over the quad's local coordinates
+    const double A = Row0[0];
+    const double B = double(Row0[1]) - Row0[0];
+    const double C = double(Row1[0]) - Row0[0];
+    const double D = double(Row0[0]) - Row0[1] - Row1[0] + Row1[1];
+
+    // Measure from the point where the segment enters the quad to keep the terms small
+    const double U0 = Start.X + Delta.X * T0 - QuadX;
+    const double V0 = Start.Y + Delta.Y * T0 - QuadY;
+    const double Z0 = Start.Z + Delta.Z * T0;
+
+    // Height of the segment above the surface is quadratic along it: C0 + C1 s + C2 s^2
+    const double C0 = Z0 - (A + B * U0 + C * V0 + D * U0 * V0);
+    const double C1 = Delta.Z - (B * Delta.X + C * Delta.Y + D * (U0 * Delta.Y + V0 * Delta.X));
+    const double C2 = -D * Delta.X * Delta.Y;
+    const double SpanLength = double(T1) - T0;
+
+    if (C0 <= 0.0)
+    {
+        OutHitTime = T0;
+        return true;
+    }
+
+    double FirstRoot = -1.0;
+    if (FMath::IsNearlyZero(C2, 1e-9))
+    {
+        if (C1 < 0.0)
+        {
+            FirstRoot = -C0 / C1;
+        }
+    }
+    else
+    {
+        const double Discriminant = C1 * C1 - 4.0 * C2 * C0;
+        if (Discriminant >= 0.0)
+        {
+            const double SqrtDiscriminant = FMath::Sqrt(Discriminant);
+            double Root0 = (-C1 - SqrtDiscriminant) / (2.0 * C2);
+            double Root1 = (-C1 + SqrtDiscriminant) / (2.0 * C2);
+            if (Root0 > Root1)
+            {
+                Swap(Root0, Root1);
+            }
+            FirstRoot = Root0 >= 0.0 ? Root0 : Root1;
+        }
+    }
+
+    if (FirstRoot < 0.0 || FirstRoot > SpanLength)
+    {
+        return false;
+    }
+
+    OutHitTime = float(T0 + FirstRoot);
+    return true;
+}
\ No newline at end of file
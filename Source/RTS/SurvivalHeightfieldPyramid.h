@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Min/max mip pyramid over the quads of a heightfield. Level 0 holds one entry per quad (the range of
+// its four corner texels), each further level the range of 2x2 cells below it. Ray marches use it to
+// skip whole cells the ray passes above (max) or to stop at cells the ray passes below (min), and only
+// intersect individual bilinear quads near the surface.
+class RTS_API FSurvivalHeightfieldPyramid
+{
+public:
+    FSurvivalHeightfieldPyramid();
+
+    void Build(const TArray<uint16>& HeightValues, int32 Width, int32 Height);
+    void Reset();
+
+    bool IsValid() const { return Levels.Num() > 0; }
+
+    // Segment in texel space (X, Y in texels, Z in 0-65535 height units) against the bilinear surface
+    // through HeightValues. Returns the parameter (0-1) of the first point at or below the surface.
+    // Parts of the segment outside the heightfield never hit.
+    bool RayMarch(const TArray<uint16>& HeightValues, const FVector& Start, const FVector& End, float& OutHitTime) const;
+
+private:
+    struct FLevel
+    {
+        int32 Width;
+        int32 Height;
+        TArray<uint16> Min;
+        TArray<uint16> Max;
+    };
+
+    // Earliest t in [T0, T1] where the segment meets the bilinear quad (QuadX, QuadY); false if it stays above
+    static bool IntersectQuad(const TArray<uint16>& HeightValues, int32 HeightfieldWidth, int32 QuadX, int32 QuadY,
+                              const FVector& Start, const FVector& Delta, float T0, float T1, float& OutHitTime);
+
+    TArray<FLevel> Levels;
+    int32 HeightfieldWidth;
+    int32 HeightfieldHeight;
+};
\ No newline at end of file
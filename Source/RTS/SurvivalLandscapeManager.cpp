@@ -1,7 +1,13 @@
 #include "SurvivalLandscapeManager.h"
+#include "SurvivalActorRegistry.h"
+#include "SurvivalStreamedHeightmap.h"
+#include "SurvivalTerrainDiskCache.h"
+#include "SurvivalTerrainKernels.h"
 // Landscape includes removed for compilation
 #include "Engine/World.h"
 #include "Kismet/GameplayStatics.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
 
 ASurvivalLandscapeManager::ASurvivalLandscapeManager()
 {
@@ -17,8 +23,17 @@ ASurvivalLandscapeManager::ASurvivalLandscapeManager()
     NoiseScale = 0.001f;     // Scale of noise relative to world coordinates
     NoiseAmplitude = 100.0f; // Maximum height variation from noise
     
+    // Tiled generation is bit-identical to the serial loop, just spread over worker threads
+    bUseTiledGeneration = true;
+    GenerationTileSize = FSurvivalTerrainTiling::DefaultTileSize;
+    
+    // 8k course split into 16x16 landscape proxies
+    StreamedHeightmapResolution = 8177;
+    StreamedTileQuads = 511;
+    
     BiomeManager = nullptr;
     TargetLandscape = nullptr;
+    GeneratedMaxElevation = 0.0f;
     
     InitializeRouteCheckpoints();
 }
@@ -30,9 +45,13 @@ void ASurvivalLandscapeManager::BeginPlay()
     // Auto-find BiomeManager if not set
     if (!BiomeManager)
     {
-        BiomeManager = Cast<ASurvivalBiomeManager>(
-            UGameplayStatics::GetActorOfClass(GetWorld(), ASurvivalBiomeManager::StaticClass())
-        );
+        BiomeManager = USurvivalActorRegistry::FindManager<ASurvivalBiomeManager>(this);
+    }
+    
+    // Keep the generated heightmap in step with live zone edits
+    if (BiomeManager)
+    {
+        BiomeManager->OnBiomeZonesChanged.AddDynamic(this, &ASurvivalLandscapeManager::HandleBiomeZonesChanged);
     }
     
     // Auto-find Landscape if not set
@@ -43,6 +62,13 @@ void ASurvivalLandscapeManager::BeginPlay()
     }
 }
 
+void ASurvivalLandscapeManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    CancelHeightmapGeneration();
+    
+    Super::EndPlay(EndPlayReason);
+}
+
 void ASurvivalLandscapeManager::InitializeRouteCheckpoints()
 {
     // Define the race route through different biomes based on design document
@@ -66,123 +92,268 @@ FSurvivalHeightmapData ASurvivalLandscapeManager::GenerateHeightmapData()
     HeightmapData.Width = HeightmapResolution;
     HeightmapData.Height = HeightmapResolution;
     HeightmapData.MaxElevation = MaxElevationVariation;
-    HeightmapData.HeightValues.SetNum(HeightmapResolution * HeightmapResolution);
     
     if (!BiomeManager)
     {
         UE_LOG(LogTemp, Warning, TEXT("BiomeManager not found - using default elevation"));
         // Fill with default flat terrain
-        for (int32 i = 0; i < HeightmapData.HeightValues.Num(); i++)
-        {
-            HeightmapData.HeightValues[i] = 16384; // Mid-range elevation
-        }
+        HeightmapData.HeightValues.Init(16384, HeightmapResolution * HeightmapResolution); // Mid-range elevation
         return HeightmapData;
     }
     
-    // Generate heightmap based on biome influences
-    for (int32 Y = 0; Y < HeightmapResolution; Y++)
+    HeightmapData.HeightValues = BuildHeightValues(BiomeManager->GetTerrainPipeline(), MakeHeightmapRequest(), BiomeManager->GetErosionSettings());
+    HeightmapData.HeightValues.SetNumZeroed(HeightmapResolution * HeightmapResolution);
+    
+    SetGeneratedHeightmap(HeightmapData);
+    
+    UE_LOG(LogTemp, Log, TEXT("Generated %dx%d heightmap with %d biome influences"), 
+           HeightmapResolution, HeightmapResolution, BiomeManager->BiomeZones.Num());
+    
+    return HeightmapData;
+}
+
+void ASurvivalLandscapeManager::GenerateHeightmapDataAsync()
+{
+    if (!BiomeManager)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("BiomeManager not found - cannot generate heightmap"));
+        return;
+    }
+    
+    // A newer request supersedes whatever is still running
+    CancelHeightmapGeneration();
+    
+    TSharedRef<FSurvivalTerrainJob> Job = MakeShared<FSurvivalTerrainJob>();
+    ActiveHeightmapJob = Job;
+    
+    FSurvivalTerrainRequest Request = MakeHeightmapRequest();
+    Request.Job = Job;
+    
+    // The worker runs on its own copy of the pipeline so zone edits and synchronous generation can't race it
+    TSharedRef<FSurvivalTerrainPipeline> Pipeline = MakeShared<FSurvivalTerrainPipeline>(BiomeManager->GetTerrainPipeline());
+    
+    TWeakObjectPtr<ASurvivalLandscapeManager> WeakThis(this);
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Pipeline, Request, Erosion = BiomeManager->GetErosionSettings()]
     {
-        for (int32 X = 0; X < HeightmapResolution; X++)
+        TArray<uint16> HeightValues = BuildHeightValues(*Pipeline, Request, Erosion);
+        
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Job = Request.Job, MaxElevation = Request.Elevation.MaxElevation,
+                                              HeightValues = MoveTemp(HeightValues)]() mutable
         {
-            // Convert heightmap coordinates to world coordinates
-            float WorldX = (X / float(HeightmapResolution - 1)) * RaceRouteWidth;
-            float WorldY = (Y / float(HeightmapResolution - 1)) * RaceRouteLength;
-            FVector WorldLocation(WorldX, WorldY, 0);
-            
-            // Start with base elevation influenced by biomes
-            float BaseElevation = 0.0f;
-            float TotalInfluence = 0.0f;
-            
-            // Sample all biome zones and blend their influences
-            for (const FBiomeZone& Biome : BiomeManager->BiomeZones)
+            ASurvivalLandscapeManager* LandscapeManager = WeakThis.Get();
+            if (!LandscapeManager || LandscapeManager->ActiveHeightmapJob != Job)
             {
-                float Distance = FVector::Dist2D(WorldLocation, Biome.CenterLocation);
-                if (Distance < Biome.Radius)
-                {
-                    float Influence = 1.0f - (Distance / Biome.Radius);
-                    Influence = FMath::SmoothStep(0.0f, 1.0f, Influence);
-                    
-                    float BiomeElevation = CalculateBiomeElevation(WorldLocation, Biome);
-                    BaseElevation += BiomeElevation * Influence;
-                    TotalInfluence += Influence;
-                }
+                return; // Cancelled or superseded
             }
             
-            if (TotalInfluence > 0.0f)
-            {
-                BaseElevation /= TotalInfluence;
-            }
-            else
+            LandscapeManager->ActiveHeightmapJob.Reset();
+            
+            if (HeightValues.Num() != LandscapeManager->HeightmapResolution * LandscapeManager->HeightmapResolution)
             {
-                BaseElevation = 200.0f; // Default elevation for areas outside biomes
+                LandscapeManager->OnHeightmapGenerated.Broadcast(false);
+                return;
             }
             
-            // Add natural terrain variation with Perlin noise
-            float NoiseVariation = ApplyPerlinNoise(WorldX, WorldY, NoiseScale, NoiseAmplitude);
-            float FinalElevation = BaseElevation + NoiseVariation;
+            FSurvivalHeightmapData HeightmapData;
+            HeightmapData.Width = LandscapeManager->HeightmapResolution;
+            HeightmapData.Height = LandscapeManager->HeightmapResolution;
+            HeightmapData.MaxElevation = MaxElevation;
+            HeightmapData.HeightValues = MoveTemp(HeightValues);
             
-            // Clamp elevation to valid range
-            FinalElevation = FMath::Clamp(FinalElevation, 0.0f, MaxElevationVariation);
+            LandscapeManager->SetGeneratedHeightmap(HeightmapData);
+            LandscapeManager->ApplyHeightmapToLandscape(HeightmapData);
             
-            // Convert to heightmap value (0-65535)
-            uint16 HeightValue = WorldHeightToHeightmapValue(FinalElevation);
-            HeightmapData.HeightValues[Y * HeightmapResolution + X] = HeightValue;
-        }
+            UE_LOG(LogTemp, Log, TEXT("Generated %dx%d heightmap in the background"), HeightmapData.Width, HeightmapData.Height);
+            LandscapeManager->OnHeightmapGenerated.Broadcast(true);
+        });
+    });
+}
+
+void ASurvivalLandscapeManager::CancelHeightmapGeneration()
+{
+    if (ActiveHeightmapJob.IsValid())
+    {
+        ActiveHeightmapJob->Cancel();
+        ActiveHeightmapJob.Reset();
+    }
+}
+
+FSurvivalTerrainRequest ASurvivalLandscapeManager::MakeHeightmapRequest() const
+{
+    FSurvivalTerrainRequest Request;
+    Request.Grid = FSurvivalTerrainGrid(HeightmapResolution, FVector2D(RaceRouteWidth, RaceRouteLength));
+    Request.bUseTiledGeneration = bUseTiledGeneration;
+    Request.TileSize = GenerationTileSize;
+    Request.bGenerateElevation = true;
+    Request.Elevation.NoiseScale = NoiseScale;
+    Request.Elevation.NoiseAmplitude = NoiseAmplitude;
+    Request.Elevation.MaxElevation = MaxElevationVariation;
+    Request.Elevation.Seed = uint32(BiomeManager->GetCourseSeed());
+    Request.Elevation.NoiseOctaves = BiomeManager->GetTerrainNoiseOctaves();
+    return Request;
+}
+
+TArray<uint16> ASurvivalLandscapeManager::BuildHeightValues(FSurvivalTerrainPipeline& Pipeline, const FSurvivalTerrainRequest& Request, const FSurvivalTerrainErosionSettings& Erosion)
+{
+    // A previous session may already have generated this exact heightmap
+    TArray<uint16> HeightValues;
+    const uint64 StageHash = FSurvivalTerrainErosion::ChainHash(Pipeline.GetStageHash(Request, ESurvivalTerrainStage::Elevation), Erosion);
+    const uint64 CacheKey = FSurvivalTerrainDiskCache::MakeKey(StageHash, TEXT("LandscapeManager.Heightmap"));
+    if (FSurvivalTerrainDiskCache::LoadHeights(CacheKey, Request.Grid.Resolution, Request.Grid.NumTexels(), HeightValues))
+    {
+        return HeightValues;
     }
     
-    UE_LOG(LogTemp, Log, TEXT("Generated %dx%d heightmap with %d biome influences"), 
-           HeightmapResolution, HeightmapResolution, BiomeManager->BiomeZones.Num());
+    // The influence field is shared with the biome manager and texture blender through the pipeline cache
+    const FSurvivalTerrainResult Result = Pipeline.Run(Request);
     
+    if (!Result.Elevation.IsValid())
+    {
+        return HeightValues;
+    }
+    
+    const TArray<float>& Elevation = Result.Elevation->Elevation;
+    HeightValues.SetNumUninitialized(Elevation.Num());
+    for (int32 TexelIndex = 0; TexelIndex < Elevation.Num(); TexelIndex++)
+    {
+        // Convert to heightmap value (0-65535)
+        HeightValues[TexelIndex] = WorldHeightToHeightmapValue(Elevation[TexelIndex], Request.Elevation.MaxElevation);
+    }
+    
+    // Same erosion as the biome manager's heightmap, so both stay in agreement
+    const FVector2D TexelSize = Request.Grid.WorldExtent / double(Request.Grid.Resolution - 1);
+    if (!FSurvivalTerrainErosion::Erode(HeightValues, Request.Grid.Resolution, Request.Grid.Resolution, TexelSize, Request.Elevation.MaxElevation, Erosion, Request.TileSize, Request.Job.Get()))
+    {
+        return TArray<uint16>(); // Cancelled
+    }
+    
+    if (!Result.WasPatched())
+    {
+        FSurvivalTerrainDiskCache::StoreHeights(CacheKey, Request.Grid.Resolution, HeightValues);
+    }
+    return HeightValues;
+}
+
+void ASurvivalLandscapeManager::SetGeneratedHeightmap(const FSurvivalHeightmapData& HeightmapData)
+{
+    // Point lookups need the raw heights, so the elevation query's copy is the retained heightmap
+    GeneratedMaxElevation = HeightmapData.MaxElevation;
+    ElevationQuery.SetHeightmap(HeightmapData.HeightValues, HeightmapData.Width, HeightmapData.Height, FVector2D(RaceRouteWidth, RaceRouteLength), HeightmapData.MaxElevation);
+}
+
+FSurvivalHeightmapData ASurvivalLandscapeManager::GetGeneratedHeightmap() const
+{
+    FSurvivalHeightmapData HeightmapData;
+    if (ElevationQuery.IsValid())
+    {
+        HeightmapData.HeightValues = ElevationQuery.GetHeightValues();
+        HeightmapData.Width = ElevationQuery.GetWidth();
+        HeightmapData.Height = ElevationQuery.GetHeight();
+        HeightmapData.MaxElevation = GeneratedMaxElevation;
+    }
     return HeightmapData;
 }
 
+bool ASurvivalLandscapeManager::GenerateStreamedHeightmap(const FString& OutputDirectory)
+{
+    if (!BiomeManager)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("BiomeManager not found - cannot generate streamed heightmap"));
+        return false;
+    }
+    
+    if (BiomeManager->GetErosionSettings().IsEnabled())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Streamed heightmaps are not eroded; %s will differ from the in-memory heightmap"), *OutputDirectory);
+    }
+    
+    FSurvivalTerrainRequest Request;
+    Request.Grid = FSurvivalTerrainGrid(StreamedHeightmapResolution, FVector2D(RaceRouteWidth, RaceRouteLength));
+    Request.TileSize = GenerationTileSize;
+    Request.bGenerateElevation = true;
+    Request.Elevation.NoiseScale = NoiseScale;
+    Request.Elevation.NoiseAmplitude = NoiseAmplitude;
+    Request.Elevation.MaxElevation = MaxElevationVariation;
+    Request.Elevation.Seed = uint32(BiomeManager->GetCourseSeed());
+    Request.Elevation.NoiseOctaves = BiomeManager->GetTerrainNoiseOctaves();
+    
+    return FSurvivalStreamedHeightmap::Generate(BiomeManager->GetTerrainPipeline(), Request, StreamedTileQuads, OutputDirectory,
+        [MaxElevation = MaxElevationVariation](float WorldHeight) { return WorldHeightToHeightmapValue(WorldHeight, MaxElevation); });
+}
+
+void ASurvivalLandscapeManager::PopulateTerrainCache(ASurvivalBiomeManager* InBiomeManager)
+{
+    if (!BiomeManager)
+    {
+        BiomeManager = InBiomeManager;
+    }
+    
+    GenerateHeightmapData();
+}
+
+void ASurvivalLandscapeManager::HandleBiomeZonesChanged(FBox2D DirtyWorldBounds)
+{
+    // A background generation started from the old layout is stale; restart it rather than apply it
+    if (IsGeneratingHeightmap())
+    {
+        GenerateHeightmapDataAsync();
+        return;
+    }
+    
+    // Nothing generated yet: the next full generation picks up the change
+    if (!BiomeManager || !ElevationQuery.IsValid())
+    {
+        return;
+    }
+    
+    // A new seed or replicated layout touches every texel, and erosion reworks the whole map after any edit;
+    // those are whole generations, so keep them off the game thread
+    if (!DirtyWorldBounds.bIsValid || BiomeManager->GetErosionSettings().IsEnabled())
+    {
+        GenerateHeightmapDataAsync();
+        return;
+    }
+    
+    // The pipeline only regenerates the texels inside DirtyWorldBounds
+    ApplyHeightmapToLandscape(GenerateHeightmapData());
+    
+    UE_LOG(LogTemp, Log, TEXT("Updated heightmap after biome zone change"));
+}
+
 float ASurvivalLandscapeManager::CalculateBiomeElevation(const FVector& WorldLocation, const FBiomeZone& Biome) const
 {
-    switch (Biome.BiomeType)
+    // Single-location path: only evaluate the noise octave this biome type actually uses
+    float HillNoise = 0.0f;
+    float TransitionNoise = 0.0f;
+    float CoreInfluence = 0.0f;
+    
+    if (Biome.BiomeType == EBiomeType::Alpine)
     {
-        case EBiomeType::Alpine:
-            // High elevation with steep gradients near center
-            {
-                float DistanceFromCenter = FVector::Dist2D(WorldLocation, Biome.CenterLocation);
-                float CenterInfluence = 1.0f - FMath::Clamp(DistanceFromCenter / (Biome.Radius * 0.3f), 0.0f, 1.0f);
-                return 800.0f + (600.0f * CenterInfluence); // 800-1400m elevation range
-            }
-            
-        case EBiomeType::Forest:
-            // Rolling hills with moderate elevation
-            {
-                float HillNoise = ApplyPerlinNoise(WorldLocation.X * 0.0005f, WorldLocation.Y * 0.0005f, 1.0f, 1.0f);
-                return 200.0f + (HillNoise * 300.0f); // 200-500m elevation range
-            }
-            
-        case EBiomeType::River:
-            // Low elevation following valley path
-            {
-                float DistanceFromRiverPath = FVector::Dist2D(WorldLocation, FVector(4000, 1000, 0));
-                float ValleyDepth = FMath::Max(0.0f, 200.0f - (DistanceFromRiverPath * 0.1f));
-                return 100.0f + ValleyDepth; // 100-300m elevation range
-            }
-            
-        case EBiomeType::Transition:
-            // Blend between adjacent biome elevations
-            return 400.0f + (ApplyPerlinNoise(WorldLocation.X * 0.001f, WorldLocation.Y * 0.001f, 1.0f, 1.0f) * 200.0f);
-            
-        default:
-            return 300.0f; // Default moderate elevation
+        CoreInfluence = FSurvivalTerrainPipeline::CalculateCoreInfluence(FVector::Dist2D(WorldLocation, Biome.CenterLocation), Biome.Radius);
+    }
+    else if (Biome.BiomeType == EBiomeType::Forest)
+    {
+        HillNoise = ApplyPerlinNoise(WorldLocation.X, WorldLocation.Y, FSurvivalTerrainPipeline::HillNoiseScale, 1.0f);
+    }
+    else if (Biome.BiomeType == EBiomeType::Transition)
+    {
+        TransitionNoise = ApplyPerlinNoise(WorldLocation.X, WorldLocation.Y, FSurvivalTerrainPipeline::TransitionNoiseScale, 1.0f);
     }
+    
+    return FSurvivalTerrainPipeline::CalculateBiomeElevation(Biome.BiomeType, WorldLocation.X, WorldLocation.Y, CoreInfluence, HillNoise, TransitionNoise);
 }
 
 float ASurvivalLandscapeManager::ApplyPerlinNoise(float X, float Y, float Scale, float Amplitude) const
 {
-    // Simple Perlin noise implementation using UE5's built-in function
-    FVector2D NoiseCoord(X * Scale, Y * Scale);
-    return FMath::PerlinNoise2D(NoiseCoord) * Amplitude;
+    // Same seeded noise the batch kernels evaluate, so single-point queries agree with the generated heightmap
+    const FSurvivalNoisePermutation Permutation(BiomeManager ? uint32(BiomeManager->GetCourseSeed()) : 0u);
+    return FSurvivalTerrainKernels::PerlinNoise2D(X * Scale, Y * Scale, Permutation) * Amplitude;
 }
 
-uint16 ASurvivalLandscapeManager::WorldHeightToHeightmapValue(float WorldHeight) const
+uint16 ASurvivalLandscapeManager::WorldHeightToHeightmapValue(float WorldHeight, float MaxElevation)
 {
-    // Convert world height (0 to MaxElevationVariation) to heightmap value (0 to 65535)
-    float NormalizedHeight = FMath::Clamp(WorldHeight / MaxElevationVariation, 0.0f, 1.0f);
+    // Convert world height (0 to MaxElevation) to heightmap value (0 to 65535)
+    float NormalizedHeight = FMath::Clamp(WorldHeight / MaxElevation, 0.0f, 1.0f);
     return static_cast<uint16>(NormalizedHeight * 65535.0f);
 }
 
@@ -226,13 +397,17 @@ void ASurvivalLandscapeManager::GenerateRaceRoute()
 
 float ASurvivalLandscapeManager::GetElevationAtWorldLocation(const FVector& WorldLocation) const
 {
+    if (ElevationQuery.IsValid())
+    {
+        return ElevationQuery.Sample(WorldLocation);
+    }
+    
     if (!TargetLandscape)
     {
         return 0.0f;
     }
     
-    // This would query the actual landscape height
-    // For now, return estimated height based on biome data
+    // No heightmap generated yet: estimate from the dominant biome
     if (BiomeManager)
     {
         FBiomeZone BiomeData = BiomeManager->GetBiomeZoneAtLocation(WorldLocation);
@@ -244,18 +419,13 @@ float ASurvivalLandscapeManager::GetElevationAtWorldLocation(const FVector& Worl
 
 float ASurvivalLandscapeManager::SampleHeightmapAtUV(const FSurvivalHeightmapData& HeightmapData, float U, float V) const
 {
-    U = FMath::Clamp(U, 0.0f, 1.0f);
-    V = FMath::Clamp(V, 0.0f, 1.0f);
-    
-    int32 X = FMath::FloorToInt(U * (HeightmapData.Width - 1));
-    int32 Y = FMath::FloorToInt(V * (HeightmapData.Height - 1));
-    
-    int32 Index = Y * HeightmapData.Width + X;
-    if (Index >= 0 && Index < HeightmapData.HeightValues.Num())
+    if (HeightmapData.Width < 2 || HeightmapData.Height < 2 || HeightmapData.HeightValues.Num() != HeightmapData.Width * HeightmapData.Height)
     {
-        uint16 HeightmapValue = HeightmapData.HeightValues[Index];
-        return (HeightmapValue / 65535.0f) * HeightmapData.MaxElevation;
+        return 0.0f;
     }
     
-    return 0.0f;
+    // Bilinear, matching GetElevationAtWorldLocation for the generated heightmap
+    const float HeightmapValue = FSurvivalElevationQuery::SampleHeightValueBilinear(HeightmapData.HeightValues.GetData(), HeightmapData.Width, HeightmapData.Height,
+                                                                                    U * (HeightmapData.Width - 1), V * (HeightmapData.Height - 1));
+    return (HeightmapValue / 65535.0f) * HeightmapData.MaxElevation;
 }
\ No newline at end of file
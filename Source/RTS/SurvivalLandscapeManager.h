@@ -4,6 +4,7 @@
 #include "Components/ActorComponent.h"
 #include "Engine/Texture2D.h"
 #include "SurvivalBiomeManager.h"
+#include "SurvivalTerrainTiling.h"
 #include "SurvivalLandscapeManager.generated.h"
 
 USTRUCT(BlueprintType)
@@ -41,6 +42,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Landscape Generation")
     class ASurvivalBiomeManager* BiomeManager;
@@ -66,6 +68,21 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Noise")
     float NoiseAmplitude;
 
+    // Split heightmap generation into tiles processed in parallel (see rts.Terrain.GenerationThreads)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Heightmap|Performance")
+    bool bUseTiledGeneration;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Heightmap|Performance", meta = (ClampMin = "8"))
+    int32 GenerationTileSize;
+
+    // Resolution of full-scale courses generated with GenerateStreamedHeightmap, which never hold the whole grid in memory
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Heightmap|Streaming", meta = (ClampMin = "2"))
+    int32 StreamedHeightmapResolution;
+
+    // Quads per streamed tile side; tiles share edge rows, so 511 quads gives 512x512-texel landscape proxies
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Heightmap|Streaming", meta = (ClampMin = "1"))
+    int32 StreamedTileQuads;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Route Generation")
     TArray<FVector> RouteCheckpoints;
 
@@ -73,6 +90,25 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Landscape Generation")
     FSurvivalHeightmapData GenerateHeightmapData();
 
+    // GenerateHeightmapData on worker threads. Cancels any generation still running; the heightmap is
+    // stored and applied on the game thread and OnHeightmapGenerated fires once it is.
+    UFUNCTION(BlueprintCallable, Category = "Landscape Generation")
+    void GenerateHeightmapDataAsync();
+
+    UFUNCTION(BlueprintCallable, Category = "Landscape Generation")
+    void CancelHeightmapGeneration();
+
+    UFUNCTION(BlueprintCallable, Category = "Landscape Generation")
+    bool IsGeneratingHeightmap() const { return ActiveHeightmapJob.IsValid(); }
+
+    UPROPERTY(BlueprintAssignable, Category = "Landscape Generation")
+    FOnTerrainGenerationCompleted OnHeightmapGenerated;
+
+    // Generates a StreamedHeightmapResolution heightmap into OutputDirectory tile by tile (see FSurvivalStreamedHeightmap).
+    // Erosion is not applied: it iterates over the whole grid, which streaming never holds in memory.
+    UFUNCTION(BlueprintCallable, Category = "Landscape Generation")
+    bool GenerateStreamedHeightmap(const FString& OutputDirectory);
+
     UFUNCTION(BlueprintCallable, Category = "Landscape Generation")
     void ApplyHeightmapToLandscape(const FSurvivalHeightmapData& HeightmapData);
 
@@ -82,12 +118,37 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Elevation")
     float GetElevationAtWorldLocation(const FVector& WorldLocation) const;
 
+    // Heightmap from the last GenerateHeightmapData call, kept current by biome zone edits. Copied out of
+    // the elevation query, which holds the only retained copy; use GetElevationQuery for lookups.
+    FSurvivalHeightmapData GetGeneratedHeightmap() const;
+
+    const FSurvivalElevationQuery& GetElevationQuery() const { return ElevationQuery; }
+
+    // Generates the heightmap into the terrain disk cache; InBiomeManager is used when none is assigned
+    void PopulateTerrainCache(ASurvivalBiomeManager* InBiomeManager);
+
     UFUNCTION(BlueprintCallable, Category = "Elevation")
     float SampleHeightmapAtUV(const FSurvivalHeightmapData& HeightmapData, float U, float V) const;
 
 private:
+    UFUNCTION()
+    void HandleBiomeZonesChanged(FBox2D DirtyWorldBounds);
+
+    void SetGeneratedHeightmap(const FSurvivalHeightmapData& HeightmapData);
+
+    FSurvivalTerrainRequest MakeHeightmapRequest() const;
+
+    // Eroded heights for Request from the disk cache or the pipeline; empty when generation was cancelled
+    static TArray<uint16> BuildHeightValues(FSurvivalTerrainPipeline& Pipeline, const FSurvivalTerrainRequest& Request, const FSurvivalTerrainErosionSettings& Erosion);
+
     void InitializeRouteCheckpoints();
     float CalculateBiomeElevation(const FVector& WorldLocation, const FBiomeZone& Biome) const;
     float ApplyPerlinNoise(float X, float Y, float Scale, float Amplitude) const;
-    uint16 WorldHeightToHeightmapValue(float WorldHeight) const;
+    static uint16 WorldHeightToHeightmapValue(float WorldHeight, float MaxElevation);
+
+    float GeneratedMaxElevation;
+    FSurvivalElevationQuery ElevationQuery;
+
+    // Job of the GenerateHeightmapDataAsync call whose result is still wanted
+    TSharedPtr<FSurvivalTerrainJob> ActiveHeightmapJob;
 };
\ No newline at end of file
@@ -1,21 +1,33 @@
 #include "SurvivalLandscapeTextureBlender.h"
+#include "SurvivalTerrainDiskCache.h"
+#include "SurvivalActorRegistry.h"
 // Landscape include removed for compilation
 #include "Materials/MaterialParameterCollectionInstance.h"
 #include "Engine/World.h"
 #include "Kismet/GameplayStatics.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
 
 ASurvivalLandscapeTextureBlender::ASurvivalLandscapeTextureBlender()
 {
-    PrimaryActorTick.bCanEverTick = false;
+    PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.bStartWithTickEnabled = false;
     
     // Initialize texture blending settings
     WeightmapResolution = 1009; // Match heightmap resolution
     BlendSmoothness = 0.8f;     // Smooth transitions between biomes
+    BlendKernelSize = 3;        // 7x7 texel smoothing window
+    bNormalizeLayerWeights = false;
     bUseAltitudeBlending = true; // Blend textures based on elevation
     
     BiomeManager = nullptr;
     TargetLandscape = nullptr;
     LandscapeMaterialCollection = nullptr;
+    
+    bUploadWeightmapTexture = true;
+    WeightmapTexture = nullptr;
+    bWeightmapUploadInFlight = false;
+    PendingWeightmapSize = FIntPoint::ZeroValue;
 }
 
 void ASurvivalLandscapeTextureBlender::BeginPlay()
@@ -25,9 +37,13 @@ void ASurvivalLandscapeTextureBlender::BeginPlay()
     // Auto-find required components
     if (!BiomeManager)
     {
-        BiomeManager = Cast<ASurvivalBiomeManager>(
-            UGameplayStatics::GetActorOfClass(GetWorld(), ASurvivalBiomeManager::StaticClass())
-        );
+        BiomeManager = USurvivalActorRegistry::FindManager<ASurvivalBiomeManager>(this);
+    }
+    
+    // Keep the generated weight maps in step with live zone edits
+    if (BiomeManager)
+    {
+        BiomeManager->OnBiomeZonesChanged.AddDynamic(this, &ASurvivalLandscapeTextureBlender::HandleBiomeZonesChanged);
     }
     
     if (!TargetLandscape)
@@ -40,6 +56,37 @@ void ASurvivalLandscapeTextureBlender::BeginPlay()
     InitializeTextureLayersForBiomes();
 }
 
+void ASurvivalLandscapeTextureBlender::PostInitializeComponents()
+{
+    Super::PostInitializeComponents();
+    
+    if (USurvivalActorRegistry* Registry = USurvivalActorRegistry::Get(this))
+    {
+        Registry->RegisterManager(this);
+    }
+}
+
+void ASurvivalLandscapeTextureBlender::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    CancelTextureWeightMapGeneration();
+    
+    if (USurvivalActorRegistry* Registry = USurvivalActorRegistry::Get(this))
+    {
+        Registry->UnregisterManager(this);
+    }
+    
+    Super::EndPlay(EndPlayReason);
+}
+
+void ASurvivalLandscapeTextureBlender::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+    
+    // Everything set since the last frame goes out as one batch
+    MaterialParameters.Flush(GetMaterialCollectionInstance());
+    SetActorTickEnabled(false);
+}
+
 void ASurvivalLandscapeTextureBlender::InitializeTextureLayersForBiomes()
 {
     if (BiomeTextureLayers.Num() == 0)
@@ -91,85 +138,311 @@ void ASurvivalLandscapeTextureBlender::CreateDefaultTextureLayers()
 
 TArray<FTextureWeightMap> ASurvivalLandscapeTextureBlender::GenerateTextureWeightMaps()
 {
-    TArray<FTextureWeightMap> WeightMaps;
-    
     if (!BiomeManager)
     {
         UE_LOG(LogTemp, Warning, TEXT("BiomeManager not found - cannot generate texture weight maps"));
-        return WeightMaps;
+        return TArray<FTextureWeightMap>();
     }
     
-    // Generate a weight map for each biome type
-    for (const FBiomeTextureLayer& TextureLayer : BiomeTextureLayers)
+    TArray<FColor> PackedTexels;
+    TArray<FTextureWeightMap> WeightMaps = BuildTextureWeightMaps(BiomeManager->GetTerrainPipeline(), MakeWeightMapRequest(),
+                                                                  bUploadWeightmapTexture ? &PackedTexels : nullptr);
+    SetGeneratedWeightMaps(WeightMaps);
+    
+    if (PackedTexels.Num() > 0)
     {
-        FTextureWeightMap WeightMap = GenerateWeightMapForBiome(TextureLayer.BiomeType);
-        WeightMaps.Add(WeightMap);
+        QueueWeightmapUpload(MoveTemp(PackedTexels), WeightmapResolution, WeightmapResolution);
     }
     
-    // Apply smoothing and blending between weight maps
-    BlendWeightMapsAtBorders(WeightMaps);
-    
     UE_LOG(LogTemp, Log, TEXT("Generated %d texture weight maps (%dx%d resolution)"), 
            WeightMaps.Num(), WeightmapResolution, WeightmapResolution);
     
     return WeightMaps;
 }
 
-FTextureWeightMap ASurvivalLandscapeTextureBlender::GenerateWeightMapForBiome(EBiomeType BiomeType)
+void ASurvivalLandscapeTextureBlender::SetGeneratedWeightMaps(const TArray<FTextureWeightMap>& WeightMaps)
+{
+    GeneratedWeightMaps.SetNum(WeightMaps.Num());
+    GeneratedWeightMapBiomes.SetNum(WeightMaps.Num());
+    
+    for (int32 LayerIndex = 0; LayerIndex < WeightMaps.Num(); LayerIndex++)
+    {
+        const FTextureWeightMap& WeightMap = WeightMaps[LayerIndex];
+        GeneratedWeightMaps[LayerIndex].Compress(WeightMap.WeightData, WeightMap.Width, WeightMap.Height);
+        GeneratedWeightMapBiomes[LayerIndex] = WeightMap.AssociatedBiome;
+    }
+}
+
+TArray<FTextureWeightMap> ASurvivalLandscapeTextureBlender::GetGeneratedWeightMaps() const
+{
+    // Full decode of every layer; only for callers that really need whole planes
+    TArray<FTextureWeightMap> WeightMaps;
+    WeightMaps.Reserve(GeneratedWeightMaps.Num());
+    
+    for (int32 LayerIndex = 0; LayerIndex < GeneratedWeightMaps.Num(); LayerIndex++)
+    {
+        FTextureWeightMap& WeightMap = WeightMaps.AddDefaulted_GetRef();
+        WeightMap.Width = GeneratedWeightMaps[LayerIndex].GetWidth();
+        WeightMap.Height = GeneratedWeightMaps[LayerIndex].GetHeight();
+        WeightMap.AssociatedBiome = GeneratedWeightMapBiomes[LayerIndex];
+        GeneratedWeightMaps[LayerIndex].Decompress(WeightMap.WeightData);
+    }
+    
+    return WeightMaps;
+}
+
+void ASurvivalLandscapeTextureBlender::GenerateTextureWeightMapsAsync()
 {
-    FTextureWeightMap WeightMap;
-    WeightMap.Width = WeightmapResolution;
-    WeightMap.Height = WeightmapResolution;
-    WeightMap.AssociatedBiome = BiomeType;
-    WeightMap.WeightData.SetNum(WeightmapResolution * WeightmapResolution);
+    if (!BiomeManager)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("BiomeManager not found - cannot generate texture weight maps"));
+        return;
+    }
+    
+    // A newer request supersedes whatever is still running
+    CancelTextureWeightMapGeneration();
+    
+    TSharedRef<FSurvivalTerrainJob> Job = MakeShared<FSurvivalTerrainJob>();
+    ActiveWeightMapJob = Job;
     
-    // Generate weights based on biome influence at each point
-    for (int32 Y = 0; Y < WeightmapResolution; Y++)
+    TWeakObjectPtr<ASurvivalLandscapeTextureBlender> WeakThis(this);
+    const FSurvivalTerrainJob* JobPtr = &Job.Get();
+    Job->OnProgress = [WeakThis, JobPtr](float Progress)
     {
-        for (int32 X = 0; X < WeightmapResolution; X++)
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, JobPtr, Progress]
         {
-            // Convert weightmap coordinates to world coordinates
-            float WorldX = (X / float(WeightmapResolution - 1)) * 5000.0f; // 5km width
-            float WorldY = (Y / float(WeightmapResolution - 1)) * 2500.0f; // 2.5km depth
-            FVector WorldLocation(WorldX, WorldY, 0);
+            ASurvivalLandscapeTextureBlender* Blender = WeakThis.Get();
+            if (Blender && Blender->ActiveWeightMapJob.Get() == JobPtr)
+            {
+                Blender->OnTextureWeightMapProgress.Broadcast(Progress);
+            }
+        });
+    };
+    
+    FSurvivalTerrainRequest Request = MakeWeightMapRequest();
+    Request.Job = Job;
+    
+    // The worker runs on its own copy of the pipeline so zone edits and synchronous generation can't race it
+    TSharedRef<FSurvivalTerrainPipeline> Pipeline = MakeShared<FSurvivalTerrainPipeline>(BiomeManager->GetTerrainPipeline());
+    
+    const bool bPackTexels = bUploadWeightmapTexture;
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Pipeline, Request, bPackTexels]
+    {
+        TArray<FColor> PackedTexels;
+        TArray<FTextureWeightMap> WeightMaps = BuildTextureWeightMaps(*Pipeline, Request, bPackTexels ? &PackedTexels : nullptr);
+        
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Job = Request.Job, Resolution = Request.Grid.Resolution,
+                                              WeightMaps = MoveTemp(WeightMaps), PackedTexels = MoveTemp(PackedTexels)]() mutable
+        {
+            ASurvivalLandscapeTextureBlender* Blender = WeakThis.Get();
+            if (!Blender || Blender->ActiveWeightMapJob != Job)
+            {
+                return; // Cancelled or superseded
+            }
             
-            // Calculate influence of this biome at this location
-            float Influence = CalculateBiomeInfluenceAtLocation(WorldLocation, BiomeType);
+            Blender->ActiveWeightMapJob.Reset();
             
-            // Add altitude-based blending if enabled
-            if (bUseAltitudeBlending)
+            if (WeightMaps.Num() == 0)
             {
-                float Altitude = WorldLocation.Z;
-                switch (BiomeType)
+                Blender->OnTextureWeightMapsGenerated.Broadcast(false);
+                return;
+            }
+            
+            Blender->SetGeneratedWeightMaps(WeightMaps);
+            
+            if (PackedTexels.Num() > 0)
+            {
+                Blender->QueueWeightmapUpload(MoveTemp(PackedTexels), Resolution, Resolution);
+            }
+            
+            UE_LOG(LogTemp, Log, TEXT("Generated %d texture weight maps in the background"), WeightMaps.Num());
+            Blender->OnTextureWeightMapsGenerated.Broadcast(true);
+        });
+    });
+}
+
+void ASurvivalLandscapeTextureBlender::CancelTextureWeightMapGeneration()
+{
+    if (ActiveWeightMapJob.IsValid())
+    {
+        ActiveWeightMapJob->Cancel();
+        ActiveWeightMapJob.Reset();
+    }
+}
+
+FSurvivalTerrainRequest ASurvivalLandscapeTextureBlender::MakeWeightMapRequest() const
+{
+    FSurvivalTerrainRequest Request;
+    Request.Grid = FSurvivalTerrainGrid(WeightmapResolution, FVector2D(5000.0f, 2500.0f)); // 5km x 2.5km course
+    Request.bGenerateLayerWeights = true;
+    Request.Layers.bUseAltitudeBlending = bUseAltitudeBlending;
+    Request.Layers.BlendSmoothness = BlendSmoothness;
+    Request.Layers.BlendKernelSize = BlendKernelSize;
+    Request.Layers.bNormalizeWeights = bNormalizeLayerWeights;
+    
+    // Altitude blending reads the race heightmap's elevation and slope; on the same grid both come from the pipeline cache
+    if (BiomeManager)
+    {
+        Request.Elevation = BiomeManager->GetTerrainElevationSettings();
+    }
+    
+    // One weight layer per biome texture layer
+    for (const FBiomeTextureLayer& TextureLayer : BiomeTextureLayers)
+    {
+        Request.Layers.LayerBiomes.Add(TextureLayer.BiomeType);
+    }
+    
+    return Request;
+}
+
+TArray<FTextureWeightMap> ASurvivalLandscapeTextureBlender::BuildTextureWeightMaps(FSurvivalTerrainPipeline& Pipeline, const FSurvivalTerrainRequest& Request, TArray<FColor>* OutPackedTexels)
+{
+    TArray<FTextureWeightMap> WeightMaps;
+    
+    const int32 Resolution = Request.Grid.Resolution;
+    const int32 NumLayers = Request.Layers.LayerBiomes.Num();
+    const int32 NumTexels = Request.Grid.NumTexels();
+    
+    TArray<uint8> PlanarWeights;
+    if (!LoadOrBuildWeights(Pipeline, Request, PlanarWeights, OutPackedTexels))
+    {
+        return WeightMaps;
+    }
+    
+    for (int32 LayerIndex = 0; LayerIndex < NumLayers; LayerIndex++)
+    {
+        FTextureWeightMap& WeightMap = WeightMaps.AddDefaulted_GetRef();
+        WeightMap.Width = Resolution;
+        WeightMap.Height = Resolution;
+        WeightMap.AssociatedBiome = Request.Layers.LayerBiomes[LayerIndex];
+        WeightMap.WeightData.Append(PlanarWeights.GetData() + LayerIndex * NumTexels, NumTexels);
+    }
+    
+    return WeightMaps;
+}
+
+bool ASurvivalLandscapeTextureBlender::LoadOrBuildWeights(FSurvivalTerrainPipeline& Pipeline, const FSurvivalTerrainRequest& Request, TArray<uint8>& OutPlanarWeights, TArray<FColor>* OutPackedTexels)
+{
+    const int32 Resolution = Request.Grid.Resolution;
+    const int32 NumLayers = Request.Layers.LayerBiomes.Num();
+    const int32 NumTexels = Request.Grid.NumTexels();
+    
+    // All layers live in one cache file, one plane after another
+    const uint64 CacheKey = FSurvivalTerrainDiskCache::MakeKey(Pipeline.GetStageHash(Request, ESurvivalTerrainStage::BorderBlend), TEXT("TextureBlender.WeightMaps"));
+    
+    if (FSurvivalTerrainDiskCache::LoadWeights(CacheKey, Resolution, NumLayers * NumTexels, OutPlanarWeights))
+    {
+        if (OutPackedTexels)
+        {
+            // The cache only holds planes; interleave them the way the border blend pass does
+            OutPackedTexels->SetNumZeroed(NumTexels);
+            for (int32 LayerIndex = 0; LayerIndex < FMath::Min(NumLayers, FSurvivalLayerWeights::MaxPackedLayers); LayerIndex++)
+            {
+                const uint8* Plane = OutPlanarWeights.GetData() + LayerIndex * NumTexels;
+                for (int32 TexelIndex = 0; TexelIndex < NumTexels; TexelIndex++)
                 {
-                    case EBiomeType::Alpine:
-                        // Alpine textures more prominent at high altitude
-                        if (Altitude > 800.0f)
-                        {
-                            Influence *= 1.0f + ((Altitude - 800.0f) / 600.0f); // Boost above 800m
-                        }
-                        break;
-                        
-                    case EBiomeType::River:
-                        // River textures more prominent at low altitude
-                        if (Altitude < 400.0f)
-                        {
-                            Influence *= 1.5f; // Boost below 400m
-                        }
-                        break;
-                        
-                    default:
-                        break;
+                    FSurvivalLayerWeights::GetPackedChannel((*OutPackedTexels)[TexelIndex], LayerIndex) = Plane[TexelIndex];
                 }
             }
-            
-            // Convert influence to weight value and store
-            uint8 WeightValue = WorldInfluenceToWeightValue(Influence);
-            WeightMap.WeightData[Y * WeightmapResolution + X] = WeightValue;
         }
+        return true;
     }
     
-    return WeightMap;
+    // Influence comes from the pipeline cache when the heightmap was generated on the same grid
+    const FSurvivalTerrainResult Result = Pipeline.Run(Request);
+    if (!Result.BlendedLayerWeights.IsValid())
+    {
+        return false;
+    }
+    
+    OutPlanarWeights.Reset(NumLayers * NumTexels);
+    for (const TArray<uint8>& Layer : Result.BlendedLayerWeights->Layers)
+    {
+        OutPlanarWeights.Append(Layer);
+    }
+    
+    if (OutPackedTexels)
+    {
+        *OutPackedTexels = Result.BlendedLayerWeights->PackedTexels;
+    }
+    
+    // Zone edits patch the weights in place; their intermediate layouts aren't persisted
+    if (!Result.WasPatched())
+    {
+        FSurvivalTerrainDiskCache::StoreWeights(CacheKey, Resolution, OutPlanarWeights);
+    }
+    return true;
+}
+
+FPackedTextureWeightMap ASurvivalLandscapeTextureBlender::GeneratePackedTextureWeightMap()
+{
+    FPackedTextureWeightMap PackedWeightMap;
+    
+    if (!BiomeManager)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("BiomeManager not found - cannot generate texture weight maps"));
+        return PackedWeightMap;
+    }
+    
+    const FSurvivalTerrainRequest Request = MakeWeightMapRequest();
+    TArray<uint8> PlanarWeights;
+    TArray<FColor> PackedTexels;
+    if (!LoadOrBuildWeights(BiomeManager->GetTerrainPipeline(), Request, PlanarWeights, &PackedTexels))
+    {
+        return PackedWeightMap;
+    }
+    
+    PackedWeightMap.Width = WeightmapResolution;
+    PackedWeightMap.Height = WeightmapResolution;
+    PackedWeightMap.Texels = MoveTemp(PackedTexels);
+    for (int32 LayerIndex = 0; LayerIndex < FMath::Min(Request.Layers.LayerBiomes.Num(), FSurvivalLayerWeights::MaxPackedLayers); LayerIndex++)
+    {
+        PackedWeightMap.ChannelBiomes.Add(Request.Layers.LayerBiomes[LayerIndex]);
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("Generated packed texture weight map with %d channels (%dx%d resolution)"),
+           PackedWeightMap.ChannelBiomes.Num(), WeightmapResolution, WeightmapResolution);
+    
+    return PackedWeightMap;
+}
+
+void ASurvivalLandscapeTextureBlender::PopulateTerrainCache(ASurvivalBiomeManager* InBiomeManager)
+{
+    if (!BiomeManager)
+    {
+        BiomeManager = InBiomeManager;
+    }
+    
+    InitializeTextureLayersForBiomes();
+    GenerateTextureWeightMaps();
+}
+
+void ASurvivalLandscapeTextureBlender::HandleBiomeZonesChanged(FBox2D DirtyWorldBounds)
+{
+    // A background generation started from the old layout is stale; restart it rather than apply it
+    if (IsGeneratingTextureWeightMaps())
+    {
+        GenerateTextureWeightMapsAsync();
+        return;
+    }
+    
+    // Nothing generated yet: the next full generation picks up the change
+    if (!BiomeManager || GeneratedWeightMaps.Num() == 0)
+    {
+        return;
+    }
+    
+    // A new seed or replicated layout touches every texel; that is a whole generation, so keep it off the game thread
+    if (!DirtyWorldBounds.bIsValid)
+    {
+        GenerateTextureWeightMapsAsync();
+        return;
+    }
+    
+    // The pipeline re-weights the dirty texels and re-blends them grown by the smoothing window
+    const TArray<FTextureWeightMap> WeightMaps = GenerateTextureWeightMaps();
+    
+    UE_LOG(LogTemp, Log, TEXT("Updated %d texture weight maps after biome zone change"), WeightMaps.Num());
 }
 
 float ASurvivalLandscapeTextureBlender::CalculateBiomeInfluenceAtLocation(const FVector& WorldLocation, EBiomeType BiomeType) const
@@ -179,101 +452,111 @@ float ASurvivalLandscapeTextureBlender::CalculateBiomeInfluenceAtLocation(const
     
     float MaxInfluence = 0.0f;
     
-    // Check influence from all biome zones of the specified type
-    for (const FBiomeZone& Biome : BiomeManager->BiomeZones)
+    // Check influence from the nearby biome zones of the specified type
+    const FSurvivalBiomeZoneIndex& ZoneIndex = BiomeManager->GetBiomeZoneIndex();
+    for (int32 Zone : ZoneIndex.GetCandidatesAtLocation(WorldLocation.X, WorldLocation.Y))
     {
-        if (Biome.BiomeType == BiomeType)
+        if (ZoneIndex.GetBiomeType(Zone) == BiomeType)
         {
-            float Distance = FVector::Dist2D(WorldLocation, Biome.CenterLocation);
-            if (Distance < Biome.Radius)
-            {
-                float Influence = 1.0f - (Distance / Biome.Radius);
-                Influence = FMath::SmoothStep(0.0f, 1.0f, Influence);
-                MaxInfluence = FMath::Max(MaxInfluence, Influence);
-            }
+            MaxInfluence = FMath::Max(MaxInfluence, ZoneIndex.GetInfluence(Zone, WorldLocation.X, WorldLocation.Y));
         }
     }
     
     return MaxInfluence;
 }
 
-uint8 ASurvivalLandscapeTextureBlender::WorldInfluenceToWeightValue(float Influence) const
-{
-    // Convert influence (0.0-1.0) to weight value (0-255)
-    Influence = FMath::Clamp(Influence, 0.0f, 1.0f);
-    return static_cast<uint8>(Influence * 255.0f);
-}
-
-void ASurvivalLandscapeTextureBlender::BlendWeightMapsAtBorders(TArray<FTextureWeightMap>& WeightMaps)
+void ASurvivalLandscapeTextureBlender::ApplyTextureWeightMapsToLandscape(const TArray<FTextureWeightMap>& WeightMaps)
 {
-    // Smooth transitions between different biome weight maps
-    const int32 BlendKernelSize = 3; // 3x3 smoothing kernel
+    if (WeightMaps.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("No texture weight maps to apply"));
+        return;
+    }
     
-    for (FTextureWeightMap& WeightMap : WeightMaps)
+    const int32 Width = WeightMaps[0].Width;
+    const int32 Height = WeightMaps[0].Height;
+    const int32 NumTexels = Width * Height;
+    const int32 NumChannels = FMath::Min(WeightMaps.Num(), FSurvivalLayerWeights::MaxPackedLayers);
+    
+    for (int32 LayerIndex = 0; LayerIndex < NumChannels; LayerIndex++)
     {
-        TArray<uint8> SmoothedData = WeightMap.WeightData;
-        
-        for (int32 Y = BlendKernelSize; Y < WeightmapResolution - BlendKernelSize; Y++)
+        if (WeightMaps[LayerIndex].WeightData.Num() != NumTexels || WeightMaps[LayerIndex].Width != Width)
         {
-            for (int32 X = BlendKernelSize; X < WeightmapResolution - BlendKernelSize; X++)
-            {
-                int32 WeightSum = 0;
-                int32 SampleCount = 0;
-                
-                // Sample surrounding pixels for smoothing
-                for (int32 DY = -BlendKernelSize; DY <= BlendKernelSize; DY++)
-                {
-                    for (int32 DX = -BlendKernelSize; DX <= BlendKernelSize; DX++)
-                    {
-                        int32 SampleIndex = (Y + DY) * WeightmapResolution + (X + DX);
-                        WeightSum += WeightMap.WeightData[SampleIndex];
-                        SampleCount++;
-                    }
-                }
-                
-                // Apply smoothed value with blend factor
-                uint8 SmoothedValue = static_cast<uint8>(WeightSum / SampleCount);
-                uint8 OriginalValue = WeightMap.WeightData[Y * WeightmapResolution + X];
-                
-                SmoothedData[Y * WeightmapResolution + X] = static_cast<uint8>(
-                    FMath::Lerp(OriginalValue, SmoothedValue, BlendSmoothness)
-                );
-            }
+            UE_LOG(LogTemp, Warning, TEXT("Texture weight maps differ in size - cannot pack them into one weightmap texture"));
+            return;
         }
-        
-        WeightMap.WeightData = SmoothedData;
     }
+    
+    // The landscape material samples WeightmapTexture; the first four layers go to R, G, B and A
+    TArray<FColor> PackedTexels;
+    PackedTexels.SetNumZeroed(NumTexels);
+    for (int32 LayerIndex = 0; LayerIndex < NumChannels; LayerIndex++)
+    {
+        const uint8* Plane = WeightMaps[LayerIndex].WeightData.GetData();
+        for (int32 TexelIndex = 0; TexelIndex < NumTexels; TexelIndex++)
+        {
+            FSurvivalLayerWeights::GetPackedChannel(PackedTexels[TexelIndex], LayerIndex) = Plane[TexelIndex];
+        }
+    }
+    
+    QueueWeightmapUpload(MoveTemp(PackedTexels), Width, Height);
+    
+    UE_LOG(LogTemp, Log, TEXT("Queued %d texture weight maps for upload (%dx%d resolution)"), NumChannels, Width, Height);
 }
 
-void ASurvivalLandscapeTextureBlender::ApplyTextureWeightMapsToLandscape(const TArray<FTextureWeightMap>& WeightMaps)
+void ASurvivalLandscapeTextureBlender::QueueWeightmapUpload(TArray<FColor>&& Texels, int32 Width, int32 Height)
 {
-    if (!TargetLandscape)
+    if (bWeightmapUploadInFlight)
     {
-        UE_LOG(LogTemp, Warning, TEXT("No target landscape set for texture weight map application"));
+        PendingWeightmapTexels = MoveTemp(Texels);
+        PendingWeightmapSize = FIntPoint(Width, Height);
         return;
     }
     
-    // In a full implementation, this would use UE5's Landscape API to apply weight maps
-    // For now, log success and provide data for blueprint/editor application
-    UE_LOG(LogTemp, Log, TEXT("Texture weight maps ready for landscape application:"));
+    bWeightmapUploadInFlight = true;
     
-    for (const FTextureWeightMap& WeightMap : WeightMaps)
+    // Diffing and mip building only read the previous chain, which stays alive and unchanged until replaced here
+    TWeakObjectPtr<ASurvivalLandscapeTextureBlender> WeakThis(this);
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Previous = UploadedWeightmap, Texels = MoveTemp(Texels), Width, Height]() mutable
     {
-        // Calculate statistics for this weight map
-        int32 NonZeroPixels = 0;
-        uint8 MaxWeight = 0;
+        TSharedRef<const FSurvivalWeightmapMipChain> Chain = FSurvivalWeightmapMipChain::Build(Previous.Get(), MoveTemp(Texels), Width, Height);
         
-        for (uint8 Weight : WeightMap.WeightData)
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Chain]
         {
-            if (Weight > 0)
-                NonZeroPixels++;
-            MaxWeight = FMath::Max(MaxWeight, Weight);
+            if (ASurvivalLandscapeTextureBlender* Blender = WeakThis.Get())
+            {
+                Blender->UploadWeightmapMipChain(Chain);
+            }
+        });
+    });
+}
+
+void ASurvivalLandscapeTextureBlender::UploadWeightmapMipChain(const TSharedRef<const FSurvivalWeightmapMipChain>& Chain)
+{
+    bWeightmapUploadInFlight = false;
+    
+    UTexture2D* Texture = FSurvivalWeightmapTexture::CreateOrReuse(WeightmapTexture, this, *Chain);
+    if (Texture)
+    {
+        // A new texture starts out with every mip of the chain, so only a reused one needs the dirty regions
+        const bool bTextureReplaced = Texture != WeightmapTexture;
+        if (!bTextureReplaced)
+        {
+            FSurvivalWeightmapTexture::UploadDirtyRegions(Texture, Chain);
         }
         
-        float Coverage = (NonZeroPixels / float(WeightMap.WeightData.Num())) * 100.0f;
+        WeightmapTexture = Texture;
+        UploadedWeightmap = Chain;
         
-        UE_LOG(LogTemp, Log, TEXT("  %s: %.1f%% coverage, max weight: %d"), 
-               *UEnum::GetValueAsString(WeightMap.AssociatedBiome), Coverage, MaxWeight);
+        if (bTextureReplaced || Chain->HasDirtyRegions())
+        {
+            OnWeightmapTextureUpdated.Broadcast(WeightmapTexture);
+        }
+    }
+    
+    if (PendingWeightmapTexels.Num() > 0)
+    {
+        QueueWeightmapUpload(MoveTemp(PendingWeightmapTexels), PendingWeightmapSize.X, PendingWeightmapSize.Y);
     }
 }
 
@@ -301,23 +584,99 @@ void ASurvivalLandscapeTextureBlender::UpdateMaterialParameters()
         return;
     }
     
-    // Update material parameters for each biome layer
-    UMaterialParameterCollectionInstance* CollectionInstance = GetWorld()->GetParameterCollectionInstance(LandscapeMaterialCollection);
+    UMaterialParameterCollectionInstance* CollectionInstance = GetMaterialCollectionInstance();
     if (!CollectionInstance)
     {
         UE_LOG(LogTemp, Warning, TEXT("Could not get material parameter collection instance"));
         return;
     }
     
-    // Set texture scale parameters for each biome
+    BindMaterialParameters();
+    
+    // Unchanged values are filtered out by the binding
+    for (int32 LayerIndex = 0; LayerIndex < BiomeTextureLayers.Num(); LayerIndex++)
+    {
+        MaterialParameters.SetScalarParameter(LayerScaleParameters[LayerIndex], BiomeTextureLayers[LayerIndex].TextureScale);
+        MaterialParameters.SetVectorParameter(LayerColorParameters[LayerIndex], BiomeTextureLayers[LayerIndex].BaseColor);
+    }
+    
+    const int32 NumPushed = MaterialParameters.Flush(CollectionInstance);
+    
+    UE_LOG(LogTemp, Verbose, TEXT("Updated %d material parameters for %d biome texture layers"), NumPushed, BiomeTextureLayers.Num());
+}
+
+void ASurvivalLandscapeTextureBlender::SetBiomeTextureScale(EBiomeType BiomeType, float TextureScale)
+{
+    BindMaterialParameters();
+    
+    for (int32 LayerIndex = 0; LayerIndex < BiomeTextureLayers.Num(); LayerIndex++)
+    {
+        if (BiomeTextureLayers[LayerIndex].BiomeType == BiomeType)
+        {
+            BiomeTextureLayers[LayerIndex].TextureScale = TextureScale;
+            MaterialParameters.SetScalarParameter(LayerScaleParameters[LayerIndex], TextureScale);
+        }
+    }
+    
+    if (MaterialParameters.HasPendingChanges())
+    {
+        SetActorTickEnabled(true);
+    }
+}
+
+void ASurvivalLandscapeTextureBlender::SetBiomeBaseColor(EBiomeType BiomeType, FLinearColor BaseColor)
+{
+    BindMaterialParameters();
+    
+    for (int32 LayerIndex = 0; LayerIndex < BiomeTextureLayers.Num(); LayerIndex++)
+    {
+        if (BiomeTextureLayers[LayerIndex].BiomeType == BiomeType)
+        {
+            BiomeTextureLayers[LayerIndex].BaseColor = BaseColor;
+            MaterialParameters.SetVectorParameter(LayerColorParameters[LayerIndex], BaseColor);
+        }
+    }
+    
+    if (MaterialParameters.HasPendingChanges())
+    {
+        SetActorTickEnabled(true);
+    }
+}
+
+void ASurvivalLandscapeTextureBlender::BindMaterialParameters()
+{
+    bool bLayersChanged = BoundLayerBiomes.Num() != BiomeTextureLayers.Num();
+    for (int32 LayerIndex = 0; LayerIndex < BiomeTextureLayers.Num() && !bLayersChanged; LayerIndex++)
+    {
+        bLayersChanged = BoundLayerBiomes[LayerIndex] != BiomeTextureLayers[LayerIndex].BiomeType;
+    }
+    
+    if (!bLayersChanged)
+    {
+        return;
+    }
+    
+    MaterialParameters.Reset();
+    LayerScaleParameters.Reset();
+    LayerColorParameters.Reset();
+    BoundLayerBiomes.Reset();
+    
     for (const FBiomeTextureLayer& Layer : BiomeTextureLayers)
     {
-        FString ScaleParamName = FString::Printf(TEXT("%s_TextureScale"), *UEnum::GetValueAsString(Layer.BiomeType));
-        FString ColorParamName = FString::Printf(TEXT("%s_BaseColor"), *UEnum::GetValueAsString(Layer.BiomeType));
-        
-        CollectionInstance->SetScalarParameterValue(*ScaleParamName, Layer.TextureScale);
-        CollectionInstance->SetVectorParameterValue(*ColorParamName, Layer.BaseColor);
+        const FString BiomeName = UEnum::GetValueAsString(Layer.BiomeType);
+        LayerScaleParameters.Add(MaterialParameters.AddScalarParameter(FName(*(BiomeName + TEXT("_TextureScale")))));
+        LayerColorParameters.Add(MaterialParameters.AddVectorParameter(FName(*(BiomeName + TEXT("_BaseColor")))));
+        BoundLayerBiomes.Add(Layer.BiomeType);
+    }
+}
+
+UMaterialParameterCollectionInstance* ASurvivalLandscapeTextureBlender::GetMaterialCollectionInstance() const
+{
+    UWorld* World = GetWorld();
+    if (!LandscapeMaterialCollection || !World)
+    {
+        return nullptr;
     }
     
-    UE_LOG(LogTemp, Log, TEXT("Updated material parameters for %d biome texture layers"), BiomeTextureLayers.Num());
+    return World->GetParameterCollectionInstance(LandscapeMaterialCollection);
 }
\ No newline at end of file
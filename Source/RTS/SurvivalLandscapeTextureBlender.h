@@ -5,8 +5,14 @@
 #include "Engine/Texture2D.h"
 #include "Materials/MaterialParameterCollection.h"
 #include "SurvivalBiomeManager.h"
+#include "SurvivalCompressedTerrainGrid.h"
+#include "SurvivalMaterialParameterBinding.h"
+#include "SurvivalWeightmapTexture.h"
 #include "SurvivalLandscapeTextureBlender.generated.h"
 
+// Fires on the game thread once a new weightmap has been queued for upload, or the texture was replaced
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnWeightmapTextureUpdated, UTexture2D*, WeightmapTexture);
+
 USTRUCT(BlueprintType)
 struct FBiomeTextureLayer
 {
@@ -70,6 +76,33 @@ struct FTextureWeightMap
     }
 };
 
+// Up to four texture layers interleaved as one FColor per texel (layer 0 in R, then G, B, A), the layout
+// landscape weightmap textures use
+USTRUCT(BlueprintType)
+struct FPackedTextureWeightMap
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TArray<FColor> Texels;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 Width;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 Height;
+
+    // Biome of each used channel, R first
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TArray<EBiomeType> ChannelBiomes;
+
+    FPackedTextureWeightMap()
+    {
+        Width = 1009;
+        Height = 1009;
+    }
+};
+
 UCLASS(BlueprintType, Blueprintable)
 class RTS_API ASurvivalLandscapeTextureBlender : public AActor
 {
@@ -80,6 +113,14 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void PostInitializeComponents() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+    // Only enabled while material parameter changes are waiting to be pushed
+    virtual void Tick(float DeltaTime) override;
+
+protected:
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Texture Blending")
     class ASurvivalBiomeManager* BiomeManager;
@@ -96,12 +137,29 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Blend Settings")
     float BlendSmoothness;
 
+    // Half-width in texels of the window biome borders are smoothed over; cost per texel is the same for any size
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Blend Settings", meta = (ClampMin = "0", ClampMax = "127"))
+    int32 BlendKernelSize;
+
+    // Make every texel's layer weights sum to 255 so the landscape material can use them without renormalizing
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Blend Settings")
+    bool bNormalizeLayerWeights;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Blend Settings")
     bool bUseAltitudeBlending;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Parameters")
     class UMaterialParameterCollection* LandscapeMaterialCollection;
 
+    // Upload the first four layers to WeightmapTexture whenever weight maps are generated or edited
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weightmap Texture")
+    bool bUploadWeightmapTexture;
+
+    // Packed layer weights with a full mip chain. Kept when it is a B8G8R8A8 texture of the weightmap's size
+    // and mip count, otherwise replaced by a transient one; only changed 64x64 tiles are re-uploaded.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weightmap Texture")
+    class UTexture2D* WeightmapTexture;
+
 public:
     UFUNCTION(BlueprintCallable, Category = "Texture Blending")
     void InitializeTextureLayersForBiomes();
@@ -109,21 +167,108 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Texture Blending")
     TArray<FTextureWeightMap> GenerateTextureWeightMaps();
 
+    // Same weights as GenerateTextureWeightMaps for the first four texture layers, written interleaved by the
+    // border blend pass instead of as separate planes
+    UFUNCTION(BlueprintCallable, Category = "Texture Blending")
+    FPackedTextureWeightMap GeneratePackedTextureWeightMap();
+
+    // GenerateTextureWeightMaps on worker threads. Cancels any generation still running; the weight maps
+    // are stored on the game thread and OnTextureWeightMapsGenerated fires once they are.
+    UFUNCTION(BlueprintCallable, Category = "Texture Blending")
+    void GenerateTextureWeightMapsAsync();
+
+    UFUNCTION(BlueprintCallable, Category = "Texture Blending")
+    void CancelTextureWeightMapGeneration();
+
+    UFUNCTION(BlueprintCallable, Category = "Texture Blending")
+    bool IsGeneratingTextureWeightMaps() const { return ActiveWeightMapJob.IsValid(); }
+
+    UPROPERTY(BlueprintAssignable, Category = "Texture Blending")
+    FOnTerrainGenerationProgress OnTextureWeightMapProgress;
+
+    UPROPERTY(BlueprintAssignable, Category = "Texture Blending")
+    FOnTerrainGenerationCompleted OnTextureWeightMapsGenerated;
+
+    UPROPERTY(BlueprintAssignable, Category = "Weightmap Texture")
+    FOnWeightmapTextureUpdated OnWeightmapTextureUpdated;
+
+    // Packs the first four weight maps into WeightmapTexture; mips are built on a worker thread
     UFUNCTION(BlueprintCallable, Category = "Texture Blending")
     void ApplyTextureWeightMapsToLandscape(const TArray<FTextureWeightMap>& WeightMaps);
 
+    UFUNCTION(BlueprintCallable, Category = "Weightmap Texture")
+    UTexture2D* GetWeightmapTexture() const { return WeightmapTexture; }
+
     UFUNCTION(BlueprintCallable, Category = "Texture Blending")
     float CalculateBiomeInfluenceAtLocation(const FVector& WorldLocation, EBiomeType BiomeType) const;
 
+    // Pushes every layer's scale and color that changed since the last push
     UFUNCTION(BlueprintCallable, Category = "Texture Blending")
     void UpdateMaterialParameters();
 
+    // Cheap enough to call every frame; changes are pushed together at the next tick
+    UFUNCTION(BlueprintCallable, Category = "Material Parameters")
+    void SetBiomeTextureScale(EBiomeType BiomeType, float TextureScale);
+
+    UFUNCTION(BlueprintCallable, Category = "Material Parameters")
+    void SetBiomeBaseColor(EBiomeType BiomeType, FLinearColor BaseColor);
+
     UFUNCTION(BlueprintCallable, Category = "Texture Layers")
     FBiomeTextureLayer GetTextureLayerForBiome(EBiomeType BiomeType) const;
 
+    // Weight maps from the last GenerateTextureWeightMaps call, kept current by biome zone edits. Expensive:
+    // every call decodes every tile of every layer into a fresh full-resolution copy, and nothing is kept.
+    // Callers after a single texel or tile should use GetCompressedWeightMaps, whose GetValue and GetTile
+    // decode one tile through the grid's LRU.
+    TArray<FTextureWeightMap> GetGeneratedWeightMaps() const;
+
+    // One grid per entry of BiomeTextureLayers at generation time
+    const TArray<FSurvivalCompressedTerrainGrid>& GetCompressedWeightMaps() const { return GeneratedWeightMaps; }
+
+    // Generates the weight maps into the terrain disk cache; InBiomeManager is used when none is assigned
+    void PopulateTerrainCache(ASurvivalBiomeManager* InBiomeManager);
+
 private:
+    UFUNCTION()
+    void HandleBiomeZonesChanged(FBox2D DirtyWorldBounds);
+
     void CreateDefaultTextureLayers();
-    FTextureWeightMap GenerateWeightMapForBiome(EBiomeType BiomeType);
-    uint8 WorldInfluenceToWeightValue(float Influence) const;
-    void BlendWeightMapsAtBorders(TArray<FTextureWeightMap>& WeightMaps);
+
+    // Resolves each layer's parameter names, again only when the layers' biomes have changed
+    void BindMaterialParameters();
+    UMaterialParameterCollectionInstance* GetMaterialCollectionInstance() const;
+
+    FSurvivalTerrainRequest MakeWeightMapRequest() const;
+    void SetGeneratedWeightMaps(const TArray<FTextureWeightMap>& WeightMaps);
+
+    // Safe on worker threads as long as Pipeline is not shared with the game thread. Fills OutPackedTexels too when given.
+    static TArray<FTextureWeightMap> BuildTextureWeightMaps(FSurvivalTerrainPipeline& Pipeline, const FSurvivalTerrainRequest& Request, TArray<FColor>* OutPackedTexels = nullptr);
+
+    // Blended weights of every layer, one plane after another, from the disk cache or the pipeline. Fills
+    // OutPackedTexels too when given. Returns false when generation was cancelled.
+    static bool LoadOrBuildWeights(FSurvivalTerrainPipeline& Pipeline, const FSurvivalTerrainRequest& Request, TArray<uint8>& OutPlanarWeights, TArray<FColor>* OutPackedTexels);
+
+    TArray<FSurvivalCompressedTerrainGrid> GeneratedWeightMaps;
+    TArray<EBiomeType> GeneratedWeightMapBiomes;
+
+    // Job of the GenerateTextureWeightMapsAsync call whose result is still wanted
+    TSharedPtr<FSurvivalTerrainJob> ActiveWeightMapJob;
+
+    // Builds the mip chain for Texels on a worker thread, then uploads what changed from the game thread
+    void QueueWeightmapUpload(TArray<FColor>&& Texels, int32 Width, int32 Height);
+    void UploadWeightmapMipChain(const TSharedRef<const FSurvivalWeightmapMipChain>& Chain);
+
+    // Chain last uploaded to WeightmapTexture; the next one is diffed against it
+    TSharedPtr<const FSurvivalWeightmapMipChain> UploadedWeightmap;
+
+    // One chain is built at a time. The newest weightmap queued meanwhile waits here, replacing older ones.
+    bool bWeightmapUploadInFlight;
+    TArray<FColor> PendingWeightmapTexels;
+    FIntPoint PendingWeightmapSize;
+
+    // Handles of each BiomeTextureLayers entry's parameters, bound for BoundLayerBiomes
+    FSurvivalMaterialParameterBinding MaterialParameters;
+    TArray<int32> LayerScaleParameters;
+    TArray<int32> LayerColorParameters;
+    TArray<EBiomeType> BoundLayerBiomes;
 };
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "SurvivalMaterialParameterBinding.h"
+#include "Materials/MaterialParameterCollectionInstance.h"
+
+FSurvivalMaterialParameterBinding::FSurvivalMaterialParameterBinding()
+{
+}
+
+int32 FSurvivalMaterialParameterBinding::AddScalarParameter(FName Name)
+{
+    return Scalars.Emplace(Name);
+}
+
+int32 FSurvivalMaterialParameterBinding::AddVectorParameter(FName Name)
+{
+    return Vectors.Emplace(Name);
+}
+
+template<typename ValueType>
+void FSurvivalMaterialParameterBinding::SetParameter(TArray<TParameter<ValueType>>& Parameters, TArray<int32>& Pending, int32 Handle, const ValueType& Value)
+{
+    TParameter<ValueType>& Parameter = Parameters[Handle];
+    Parameter.Value = Value;
+    Parameter.bHasValue = true;
+
+    // Values equal to what the collection already holds never reach it
+    if (!Parameter.bPending && (!Parameter.bPushed || Parameter.PushedValue != Value))
+    {
+        Parameter.bPending = true;
+        Pending.Add(Handle);
+    }
+}
+
+void FSurvivalMaterialParameterBinding::SetScalarParameter(int32 Handle, float Value)
+{
+    SetParameter(Scalars, PendingScalars, Handle, Value);
+}
+
+void FSurvivalMaterialParameterBinding::SetVectorParameter(int32 Handle, const FLinearColor& Value)
+{
+    SetParameter(Vectors, PendingVectors, Handle, Value);
+}
+
+template<typename ValueType>
+void FSurvivalMaterialParameterBinding::MarkAllPending(TArray<TParameter<ValueType>>& Parameters, TArray<int32>& Pending)
+{
+    Pending.Reset();
+    for (int32 Handle = 0; Handle < Parameters.Num(); Handle++)
+    {
+        TParameter<ValueType>& Parameter = Parameters[Handle];
+        Parameter.bPushed = false;
+        Parameter.bMissing = false;
+        Parameter.bPending = Parameter.bHasValue;
+        if (Parameter.bPending)
+        {
+            Pending.Add(Handle);
+        }
+    }
+}
+
+int32 FSurvivalMaterialParameterBinding::Flush(UMaterialParameterCollectionInstance* Instance)
+{
+    if (!Instance)
+    {
+        return 0;
+    }
+
+    if (LastInstance.Get() != Instance)
+    {
+        LastInstance = Instance;
+        MarkAllPending(Scalars, PendingScalars);
+        MarkAllPending(Vectors, PendingVectors);
+    }
+
+    int32 NumPushed = 0;
+
+    for (int32 Handle : PendingScalars)
+    {
+        TParameter<float>& Parameter = Scalars[Handle];
+        Parameter.bPending = false;
+        if (Parameter.bMissing || (Parameter.bPushed && Parameter.PushedValue == Parameter.Value))
+        {
+            continue;
+        }
+
+        if (!Instance->SetScalarParameterValue(Parameter.Name, Parameter.Value))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Material parameter collection has no scalar parameter %s"), *Parameter.Name.ToString());
+            Parameter.bMissing = true;
+            continue;
+        }
+
+        Parameter.PushedValue = Parameter.Value;
+        Parameter.bPushed = true;
+        NumPushed++;
+    }
+    PendingScalars.Reset();
+
+    for (int32 Handle : PendingVectors)
+    {
+        TParameter<FLinearColor>& Parameter = Vectors[Handle];
+        Parameter.bPending = false;
+        if (Parameter.bMissing || (Parameter.bPushed && Parameter.PushedValue == Parameter.Value))
+        {
+            continue;
+        }
+
+        if (!Instance->SetVectorParameterValue(Parameter.Name, Parameter.Value))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Material parameter collection has no vector parameter %s"), *Parameter.Name.ToString());
+            Parameter.bMissing = true;
+            continue;
+        }
+
+        Parameter.PushedValue = Parameter.Value;
+        Parameter.bPushed = true;
+        NumPushed++;
+    }
+    PendingVectors.Reset();
+
+    return NumPushed;
+}
+
+void FSurvivalMaterialParameterBinding::Reset()
+{
+    Scalars.Reset();
+    Vectors.Reset();
+    PendingScalars.Reset();
+    PendingVectors.Reset();
+    LastInstance.Reset();
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UMaterialParameterCollectionInstance;
+
+// Scalar and vector parameters of a material parameter collection, bound by name once and pushed in batches.
+// Setters only record values; Flush sends those that differ from what was last pushed.
+class RTS_API FSurvivalMaterialParameterBinding
+{
+public:
+    FSurvivalMaterialParameterBinding();
+
+    // Handles index the binding's own tables; names are resolved here and never again
+    int32 AddScalarParameter(FName Name);
+    int32 AddVectorParameter(FName Name);
+
+    void SetScalarParameter(int32 Handle, float Value);
+    void SetVectorParameter(int32 Handle, const FLinearColor& Value);
+
+    bool HasPendingChanges() const { return PendingScalars.Num() > 0 || PendingVectors.Num() > 0; }
+
+    // Pushes the changed parameters to Instance and returns how many were pushed. A different instance than
+    // last time gets every parameter, since its values are unknown.
+    int32 Flush(UMaterialParameterCollectionInstance* Instance);
+
+    // Drops every parameter and the pushed values
+    void Reset();
+
+private:
+    template<typename ValueType>
+    struct TParameter
+    {
+        FName Name;
+        ValueType Value;
+        ValueType PushedValue;
+        bool bHasValue;
+        bool bPushed;
+        bool bPending;
+        // Set when the collection has no parameter of this name, so it isn't retried every flush
+        bool bMissing;
+
+        explicit TParameter(FName InName)
+            : Name(InName), Value(), PushedValue(), bHasValue(false), bPushed(false), bPending(false), bMissing(false)
+        {
+        }
+    };
+
+    template<typename ValueType>
+    static void SetParameter(TArray<TParameter<ValueType>>& Parameters, TArray<int32>& Pending, int32 Handle, const ValueType& Value);
+
+    template<typename ValueType>
+    static void MarkAllPending(TArray<TParameter<ValueType>>& Parameters, TArray<int32>& Pending);
+
+    TArray<TParameter<float>> Scalars;
+    TArray<TParameter<FLinearColor>> Vectors;
+
+    // Handles with a value not yet pushed, in the order they were first set
+    TArray<int32> PendingScalars;
+    TArray<int32> PendingVectors;
+
+    TWeakObjectPtr<UMaterialParameterCollectionInstance> LastInstance;
+};
\ No newline at end of file
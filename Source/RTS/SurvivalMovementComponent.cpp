@@ -1,4 +1,5 @@
 #include "SurvivalMovementComponent.h"
+#include "SurvivalActorRegistry.h"
 #include "Engine/Engine.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
 #include "Components/PrimitiveComponent.h"
@@ -23,7 +24,11 @@ USurvivalMovementComponent::USurvivalMovementComponent()
     
     BiomeSpeedMultiplier = 1.0f;
     BiomeStaminaMultiplier = 1.0f;
+    BiomeHysteresisDistance = 10.0f; // Two biome raster cells
     BiomeManager = nullptr;
+    CachedBiomeCell = INDEX_NONE;
+    CachedBoundaryDistance = 0.0f;
+    LastBiomeEvaluationLocation = FVector2D::ZeroVector;
     
     // Initialize sound assets to nullptr
     GrassFootstepSound = nullptr;
@@ -40,10 +45,20 @@ void USurvivalMovementComponent::BeginPlay()
     // Find BiomeManager in the world if not manually assigned
     if (!BiomeManager)
     {
-        BiomeManager = Cast<ASurvivalBiomeManager>(UGameplayStatics::GetActorOfClass(GetWorld(), ASurvivalBiomeManager::StaticClass()));
+        BiomeManager = USurvivalActorRegistry::FindManager<ASurvivalBiomeManager>(this);
+    }
+    
+    if (BiomeManager)
+    {
+        BiomeManager->OnBiomeZonesChanged.AddDynamic(this, &USurvivalMovementComponent::HandleBiomeZonesChanged);
     }
 }
 
+void USurvivalMovementComponent::HandleBiomeZonesChanged(FBox2D DirtyWorldBounds)
+{
+    CachedBiomeCell = INDEX_NONE;
+}
+
 void USurvivalMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
@@ -101,9 +116,11 @@ void USurvivalMovementComponent::DetectTerrainType()
     FHitResult Hit;
     FCollisionQueryParams QueryParams;
     QueryParams.AddIgnoredActor(GetOwner());
+    QueryParams.bReturnPhysicalMaterial = true;
 
     ETerrainType NewTerrainType = ETerrainType::Unknown;
 
+    // The generated heightfield doesn't drive the landscape yet, so the surface comes from the physics scene
     if (GetWorld()->LineTraceSingleByChannel(Hit, Start, End, ECC_WorldStatic, QueryParams))
     {
         if (Hit.PhysMaterial.IsValid())
@@ -113,27 +130,25 @@ void USurvivalMovementComponent::DetectTerrainType()
             // Map physical material to terrain resistance based on design document
             if (PhysMat->GetName().Contains("Grass"))
             {
-                SetTerrainResistance(1.0f); // Base speed
                 NewTerrainType = ETerrainType::Grass;
             }
             else if (PhysMat->GetName().Contains("Mud"))
             {
-                SetTerrainResistance(0.714f); // 1.4x resistance = 1/1.4 speed
                 NewTerrainType = ETerrainType::Mud;
             }
             else if (PhysMat->GetName().Contains("Water"))
             {
-                SetTerrainResistance(0.625f); // 1.6x resistance = 1/1.6 speed
                 NewTerrainType = ETerrainType::Water;
             }
             else if (PhysMat->GetName().Contains("Rock"))
             {
-                SetTerrainResistance(0.833f); // 1.2x resistance = 1/1.2 speed
                 NewTerrainType = ETerrainType::Rock;
             }
         }
     }
 
+    ApplyTerrainType(NewTerrainType);
+
     // Check for terrain type changes and broadcast events
     if (NewTerrainType != CurrentTerrainType)
     {
@@ -145,6 +160,27 @@ void USurvivalMovementComponent::DetectTerrainType()
     }
 }
 
+void USurvivalMovementComponent::ApplyTerrainType(ETerrainType TerrainType)
+{
+    switch (TerrainType)
+    {
+    case ETerrainType::Grass:
+        SetTerrainResistance(1.0f); // Base speed
+        break;
+    case ETerrainType::Mud:
+        SetTerrainResistance(0.714f); // 1.4x resistance = 1/1.4 speed
+        break;
+    case ETerrainType::Water:
+        SetTerrainResistance(0.625f); // 1.6x resistance = 1/1.6 speed
+        break;
+    case ETerrainType::Rock:
+        SetTerrainResistance(0.833f); // 1.2x resistance = 1/1.2 speed
+        break;
+    default:
+        break;
+    }
+}
+
 void USurvivalMovementComponent::PlayFootstepSound()
 {
     USoundBase* FootstepSound = nullptr;
@@ -186,18 +222,58 @@ void USurvivalMovementComponent::DetectBiomeEffects()
     if (!BiomeManager || !GetOwner())
         return;
 
-    FVector CurrentLocation = GetOwner()->GetActorLocation();
-    EBiomeType NewBiome = BiomeManager->GetBiomeAtLocation(CurrentLocation);
+    const FVector CurrentLocation = GetOwner()->GetActorLocation();
+    
+    // Multipliers blend continuously across borders: one bilinear fetch per tick, independent of the biome switch below
+    const FSurvivalBiomeMultiplierField& MultiplierField = BiomeManager->GetBiomeMultiplierField();
+    if (MultiplierField.IsValid())
+    {
+        const FVector2f Multipliers = MultiplierField.Sample(CurrentLocation.X, CurrentLocation.Y);
+        BiomeSpeedMultiplier = Multipliers.X;
+        BiomeStaminaMultiplier = Multipliers.Y;
+    }
+    
+    const FSurvivalBiomeRaster& BiomeRaster = BiomeManager->GetBiomeRaster();
+    const int32 CellIndex = BiomeRaster.IsValid() ? BiomeRaster.GetCellIndex(CurrentLocation.X, CurrentLocation.Y) : INDEX_NONE;
+    
+    // Neither the zone nor the hysteresis band can change until the character leaves the last evaluated cell and
+    // covers the margin it had to the nearest boundary, less a cell for where inside their cells both samples fell
+    const FVector2D Location2D(CurrentLocation.X, CurrentLocation.Y);
+    if (CellIndex != INDEX_NONE && CachedBiomeCell != INDEX_NONE)
+    {
+        const float SafeTravelDistance = CachedBoundaryDistance - BiomeHysteresisDistance - BiomeRaster.GetCellSize();
+        if (CellIndex == CachedBiomeCell || FVector2D::DistSquared(Location2D, LastBiomeEvaluationLocation) < FMath::Square(FMath::Max(SafeTravelDistance, 0.0f)))
+        {
+            return;
+        }
+    }
+    
+    const bool bFirstEvaluation = CachedBiomeCell == INDEX_NONE;
+    CachedBiomeCell = CellIndex;
+    LastBiomeEvaluationLocation = Location2D;
+    CachedBoundaryDistance = CellIndex != INDEX_NONE
+        ? BiomeRaster.GetDistanceToZoneBoundary(CellIndex, FSurvivalBiomeRaster::MaxBoundarySearchCells * BiomeRaster.GetCellSize())
+        : 0.0f;
     
-    if (NewBiome != CurrentBiome)
+    // One raster lookup gives both the biome and, without a multiplier field, the zone the multipliers come from
+    const FBiomeZone* Zone = BiomeManager->FindBiomeZoneAtLocation(CurrentLocation);
+    EBiomeType NewBiome = Zone ? Zone->BiomeType : EBiomeType::Forest;
+    
+    // Inside the hysteresis band the previous biome holds, on whichever side of the border the character is.
+    // The first evaluation (spawn, or a new zone layout) has no previous biome worth holding.
+    const bool bNearBoundary = CellIndex != INDEX_NONE && CachedBoundaryDistance < BiomeHysteresisDistance;
+    
+    if (NewBiome != CurrentBiome && (!bNearBoundary || bFirstEvaluation))
     {
         LastBiome = CurrentBiome;
         CurrentBiome = NewBiome;
         
-        // Get biome zone data for multipliers
-        FBiomeZone BiomeData = BiomeManager->GetBiomeZoneAtLocation(CurrentLocation);
-        BiomeSpeedMultiplier = BiomeData.MovementSpeedMultiplier;
-        BiomeStaminaMultiplier = BiomeData.CalorieBurnMultiplier;
+        // Without a multiplier field the dominant zone's values apply; outside every zone the defaults
+        if (!MultiplierField.IsValid())
+        {
+            BiomeSpeedMultiplier = Zone ? Zone->MovementSpeedMultiplier : 1.0f;
+            BiomeStaminaMultiplier = Zone ? Zone->CalorieBurnMultiplier : 1.0f;
+        }
         
         UE_LOG(LogTemp, Log, TEXT("Entered %s biome - Speed: %.2fx, Stamina: %.2fx"), 
                *UEnum::GetValueAsString(CurrentBiome), BiomeSpeedMultiplier, BiomeStaminaMultiplier);
@@ -57,6 +57,11 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Biome System")
     float BiomeStaminaMultiplier;
 
+    // How far (world units) into a new biome the character must be before it takes effect, so walking along a
+    // border doesn't flicker between the two
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Biome System", meta = (ClampMin = "0"))
+    float BiomeHysteresisDistance;
+
 public:
     virtual void BeginPlay() override;
     virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
@@ -92,6 +97,19 @@ protected:
     void PlayFootstepSound();
 
 private:
+    // Sets the speed multiplier for a detected terrain type; Unknown leaves it unchanged
+    void ApplyTerrainType(ETerrainType TerrainType);
+
+    // Zone edits re-bake the biome raster, so the cached cell says nothing about the new layout
+    UFUNCTION()
+    void HandleBiomeZonesChanged(FBox2D DirtyWorldBounds);
+
+    // Biome raster cell and location the biome was last evaluated at (INDEX_NONE off the course or before the
+    // first evaluation), and that cell's distance to the nearest zone boundary out to the raster's search limit
+    int32 CachedBiomeCell;
+    FVector2D LastBiomeEvaluationLocation;
+    float CachedBoundaryDistance;
+
     float BaseMaxSpeed;
     ETerrainType CurrentTerrainType;
     ETerrainType LastTerrainType;
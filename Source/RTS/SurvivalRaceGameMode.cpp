@@ -2,6 +2,9 @@
 #include "SurvivalRaceGameState.h"
 #include "SurvivalPlayerState.h"
 #include "SurvivalCharacter.h"
+#include "SurvivalBiomeManager.h"
+#include "SurvivalLandscapeTextureBlender.h"
+#include "SurvivalActorRegistry.h"
 #include "Engine/Engine.h"
 #include "GameFramework/PlayerController.h"
 #include "Kismet/GameplayStatics.h"
@@ -17,6 +20,11 @@ ASurvivalRaceGameMode::ASurvivalRaceGameMode()
     RaceTimeLimit = 10800.0f; // 3 hours in seconds
     MaxTetherDistance = 50.0f; // 50 meter tether constraint
     MinPlayersToStart = 4; // Minimum 2 teams of 2 players
+    bGenerateCourseDuringLobby = true;
+    bRandomizeCourseSeed = false;
+    bCourseGenerationStarted = false;
+    bRaceWasInProgress = false;
+    BiomeManager = nullptr;
 
     // Initialize timing
     LastTetherCheck = 0.0f;
@@ -33,6 +41,12 @@ void ASurvivalRaceGameMode::PostLogin(APlayerController* NewPlayer)
     {
         UE_LOG(LogTemp, Log, TEXT("Player logged in: %s"), *NewPlayer->GetName());
         
+        // Build the course while the lobby fills up instead of hitching when the race starts
+        if (bGenerateCourseDuringLobby && !bCourseGenerationStarted && SurvivalGameState && !SurvivalGameState->bRaceInProgress)
+        {
+            StartCourseGeneration();
+        }
+        
         // Assign player to team
         AssignPlayerToTeam(NewPlayer);
         
@@ -63,6 +77,8 @@ void ASurvivalRaceGameMode::BeginPlay()
     {
         UE_LOG(LogTemp, Error, TEXT("SurvivalRaceGameMode: Failed to get SurvivalRaceGameState"));
     }
+    
+    BiomeManager = USurvivalActorRegistry::FindManager<ASurvivalBiomeManager>(this);
 }
 
 void ASurvivalRaceGameMode::Tick(float DeltaTime)
@@ -71,6 +87,8 @@ void ASurvivalRaceGameMode::Tick(float DeltaTime)
 
     if (SurvivalGameState && SurvivalGameState->bRaceInProgress)
     {
+        bRaceWasInProgress = true;
+        
         // Periodic checks during race
         LastTetherCheck += DeltaTime;
         if (LastTetherCheck >= TetherCheckInterval)
@@ -81,6 +99,49 @@ void ASurvivalRaceGameMode::Tick(float DeltaTime)
             LastTetherCheck = 0.0f;
         }
     }
+    else if (bRaceWasInProgress)
+    {
+        HandleRaceEnded();
+    }
+}
+
+void ASurvivalRaceGameMode::HandleRaceEnded()
+{
+    bRaceWasInProgress = false;
+    bCourseGenerationStarted = false;
+    
+    // Players stay in the lobby for the next race, so no PostLogin will start its course
+    if (bGenerateCourseDuringLobby && GetNumPlayers() > 0)
+    {
+        StartCourseGeneration();
+    }
+}
+
+void ASurvivalRaceGameMode::StartCourseGeneration()
+{
+    bCourseGenerationStarted = true;
+    
+    if (BiomeManager)
+    {
+        if (bRandomizeCourseSeed)
+        {
+            BiomeManager->SetCourseSeed(FMath::RandRange(1, MAX_int32));
+        }
+        
+        // A new seed already restarted generation of anything built from the old one
+        if (!BiomeManager->IsGeneratingTerrain())
+        {
+            BiomeManager->GenerateRaceLandscapeAsync();
+        }
+    }
+    
+    ASurvivalLandscapeTextureBlender* TextureBlender = USurvivalActorRegistry::FindManager<ASurvivalLandscapeTextureBlender>(this);
+    if (TextureBlender && !TextureBlender->IsGeneratingTextureWeightMaps())
+    {
+        TextureBlender->GenerateTextureWeightMapsAsync();
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("Started background course generation"));
 }
 
 void ASurvivalRaceGameMode::StartRaceCountdown()
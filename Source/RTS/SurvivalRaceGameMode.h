@@ -7,6 +7,7 @@
 class ASurvivalRaceGameState;
 class ASurvivalPlayerState;
 class ASurvivalCharacter;
+class ASurvivalBiomeManager;
 
 UCLASS()
 class RTS_API ASurvivalRaceGameMode : public AGameModeBase
@@ -31,9 +32,21 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Race Config")
     int32 MinPlayersToStart;
 
+    // Generate the course terrain in the background once the first player joins the lobby
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Race Config")
+    bool bGenerateCourseDuringLobby;
+
+    // Pick a fresh course seed for every match; only the seed and zones are sent to clients
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Race Config")
+    bool bRandomizeCourseSeed;
+
     UPROPERTY(BlueprintReadOnly, Category = "Race State")
     ASurvivalRaceGameState* SurvivalGameState;
 
+    // Course terrain generated while the lobby fills
+    UPROPERTY(BlueprintReadOnly, Category = "Race State")
+    ASurvivalBiomeManager* BiomeManager;
+
 public:
     UFUNCTION(BlueprintCallable, Category = "Race Management")
     void StartRaceCountdown();
@@ -41,6 +54,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Race Management")
     void CheckRaceConditions();
 
+    // Starts background heightmap and weight map generation for the course, unless it is already running for the current layout
+    UFUNCTION(BlueprintCallable, Category = "Race Management")
+    void StartCourseGeneration();
+
     UFUNCTION(BlueprintCallable, Category = "Team Management")
     void AssignPlayerToTeam(APlayerController* PlayerController);
 
@@ -70,7 +87,13 @@ private:
     void CheckTetherConstraints();
     void CheckEliminationConditions();
     void UpdateTeamCohesionScores();
+
+    // Re-arms lobby course generation for the next race
+    void HandleRaceEnded();
     
     float LastTetherCheck;
     float TetherCheckInterval;
+
+    bool bCourseGenerationStarted;
+    bool bRaceWasInProgress;
 };
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "SurvivalRacePathManager.h"
+#include "SurvivalActorRegistry.h"
 #include "Components/SplineComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "Engine/World.h"
@@ -30,9 +31,7 @@ void ASurvivalRacePathManager::BeginPlay()
     // Auto-find BiomeManager
     if (!BiomeManager)
     {
-        BiomeManager = Cast<ASurvivalBiomeManager>(
-            UGameplayStatics::GetActorOfClass(GetWorld(), ASurvivalBiomeManager::StaticClass())
-        );
+        BiomeManager = USurvivalActorRegistry::FindManager<ASurvivalBiomeManager>(this);
     }
     
     // Initialize and generate the race path
@@ -190,11 +189,11 @@ FVector ASurvivalRacePathManager::InterpolatePathElevation(const FVector& BaseLo
 {
     FVector Result = BaseLocation;
     
-    // If we have a BiomeManager, get more accurate elevation
-    if (BiomeManager)
+    // Snap to the generated terrain; bicubic keeps the spline free of kinks at texel boundaries.
+    // Until a heightmap is on the landscape the checkpoint's own Z is used.
+    if (BiomeManager && BiomeManager->IsHeightmapApplied())
     {
-        // This would query the landscape or biome system for actual elevation
-        // For now, use the Z value from the checkpoint
+        Result.Z = BiomeManager->GetElevationQuery().Sample(BaseLocation, ESurvivalElevationFilter::Bicubic);
     }
     
     return Result;
@@ -378,10 +377,24 @@ TArray<float> ASurvivalRacePathManager::GetElevationProfile(int32 SampleCount) c
     float TotalLength = CalculatePathTotalLength();
     float SampleDistance = TotalLength / SampleCount;
     
+    TArray<FVector> SampleLocations;
+    SampleLocations.Reserve(SampleCount);
     for (int32 i = 0; i < SampleCount; i++)
     {
         float Distance = i * SampleDistance;
-        FVector Location = GetPathLocationAtDistance(Distance);
+        SampleLocations.Add(GetPathLocationAtDistance(Distance));
+    }
+    
+    // Terrain under the path in one batched lookup; the spline's own Z until a heightmap is on the landscape
+    if (BiomeManager && BiomeManager->IsHeightmapApplied())
+    {
+        ElevationProfile.SetNumUninitialized(SampleCount);
+        BiomeManager->GetElevationQuery().SampleBatch(SampleLocations, ElevationProfile, ESurvivalElevationFilter::Bicubic);
+        return ElevationProfile;
+    }
+    
+    for (const FVector& Location : SampleLocations)
+    {
         ElevationProfile.Add(Location.Z);
     }
     
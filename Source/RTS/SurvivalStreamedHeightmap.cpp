@@ -0,0 +1,204 @@
+#include "SurvivalStreamedHeightmap.h"
+#include "SurvivalTerrainPipeline.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include <atomic>
+
+namespace SurvivalStreamedHeightmapFormat
+{
+    constexpr uint32 Magic = 0x48535452; // 'RTSH'
+
+    // Bump when the manifest or tile layout changes
+    constexpr uint32 FormatVersion = 1;
+}
+
+FSurvivalTerrainTile FSurvivalHeightmapTileLayout::GetTileTexels(int32 TileX, int32 TileY) const
+{
+    const int32 MinX = TileX * TileQuads;
+    const int32 MinY = TileY * TileQuads;
+
+    // One texel past the last quad: the edge shared with the next tile
+    return FSurvivalTerrainTile(MinX, MinY, FMath::Min(MinX + TileQuads + 1, Resolution), FMath::Min(MinY + TileQuads + 1, Resolution));
+}
+
+FSurvivalStreamedHeightmap::FSurvivalStreamedHeightmap()
+    : WorldExtent(FVector2D::ZeroVector)
+    , MaxElevation(0.0f)
+{
+}
+
+bool FSurvivalStreamedHeightmap::Generate(const FSurvivalTerrainPipeline& Pipeline, const FSurvivalTerrainRequest& Request, int32 TileQuads,
+                                          const FString& Directory, TFunctionRef<uint16(float)> HeightToValue)
+{
+    using namespace SurvivalStreamedHeightmapFormat;
+
+    const FSurvivalHeightmapTileLayout Layout(Request.Grid.Resolution, TileQuads);
+    if (!Layout.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Streamed heightmap: invalid layout (resolution %d, %d quads per tile)"), Layout.Resolution, Layout.TileQuads);
+        return false;
+    }
+
+    IFileManager& FileManager = IFileManager::Get();
+
+    // A manifest left from an earlier run would describe tiles that are about to be overwritten
+    FileManager.Delete(*GetManifestPath(Directory), false, false, true);
+    FileManager.MakeDirectory(*Directory, true);
+
+    TArray<FSurvivalTerrainTile> Tiles;
+    Tiles.Reserve(Layout.GetNumTiles());
+    for (int32 TileY = 0; TileY < Layout.GetNumTilesPerSide(); TileY++)
+    {
+        for (int32 TileX = 0; TileX < Layout.GetNumTilesPerSide(); TileX++)
+        {
+            Tiles.Add(Layout.GetTileTexels(TileX, TileY));
+        }
+    }
+
+    std::atomic<int32> NumFailedTiles(0);
+    Pipeline.GenerateElevationTiles(Request, Tiles, [&Directory, &HeightToValue, &FileManager, &NumFailedTiles, TileQuads](const FSurvivalTerrainTile& Tile, const FSurvivalElevationField& Elevation)
+    {
+        TArray<uint16> HeightValues;
+        HeightValues.SetNumUninitialized(Elevation.Elevation.Num());
+        for (int32 TexelIndex = 0; TexelIndex < HeightValues.Num(); TexelIndex++)
+        {
+            HeightValues[TexelIndex] = HeightToValue(Elevation.Elevation[TexelIndex]);
+        }
+
+        const FString TilePath = GetTilePath(Directory, Tile.MinX / TileQuads, Tile.MinY / TileQuads);
+        TUniquePtr<FArchive> Writer(FileManager.CreateFileWriter(*TilePath));
+        if (!Writer)
+        {
+            NumFailedTiles++;
+            return;
+        }
+
+        Writer->Serialize(HeightValues.GetData(), HeightValues.Num() * sizeof(uint16));
+        if (!Writer->Close() || Writer->IsError())
+        {
+            NumFailedTiles++;
+        }
+    });
+
+    if (NumFailedTiles > 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Streamed heightmap: could not write %d of %d tiles to %s"), NumFailedTiles.load(), Tiles.Num(), *Directory);
+        return false;
+    }
+
+    TUniquePtr<FArchive> ManifestWriter(FileManager.CreateFileWriter(*GetManifestPath(Directory)));
+    if (!ManifestWriter)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Streamed heightmap: could not write manifest to %s"), *Directory);
+        return false;
+    }
+
+    uint32 FileMagic = Magic;
+    uint32 FileVersion = FormatVersion;
+    int32 Resolution = Layout.Resolution;
+    FVector2D Extent = Request.Grid.WorldExtent;
+    float Elevation = Request.Elevation.MaxElevation;
+    *ManifestWriter << FileMagic << FileVersion << Resolution << TileQuads << Extent << Elevation;
+
+    if (!ManifestWriter->Close() || ManifestWriter->IsError())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Streamed heightmap: could not write manifest to %s"), *Directory);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Streamed %dx%d heightmap as %d tiles into %s"), Layout.Resolution, Layout.Resolution, Tiles.Num(), *Directory);
+    return true;
+}
+
+bool FSurvivalStreamedHeightmap::Open(const FString& InDirectory)
+{
+    using namespace SurvivalStreamedHeightmapFormat;
+
+    Layout = FSurvivalHeightmapTileLayout();
+
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*GetManifestPath(InDirectory)));
+    if (!Reader)
+    {
+        return false;
+    }
+
+    uint32 FileMagic = 0;
+    uint32 FileVersion = 0;
+    *Reader << FileMagic << FileVersion;
+    if (FileMagic != Magic || FileVersion != FormatVersion)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Streamed heightmap: %s has an unknown format"), *InDirectory);
+        return false;
+    }
+
+    FSurvivalHeightmapTileLayout FileLayout;
+    *Reader << FileLayout.Resolution << FileLayout.TileQuads << WorldExtent << MaxElevation;
+    if (Reader->IsError() || !FileLayout.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Streamed heightmap: %s has a corrupt manifest"), *InDirectory);
+        return false;
+    }
+
+    Directory = InDirectory;
+    Layout = FileLayout;
+    return true;
+}
+
+bool FSurvivalStreamedHeightmap::LoadTile(int32 TileX, int32 TileY, FSurvivalHeightmapTile& OutTile) const
+{
+    const int32 NumTilesPerSide = Layout.GetNumTilesPerSide();
+    if (!IsOpen() || TileX < 0 || TileY < 0 || TileX >= NumTilesPerSide || TileY >= NumTilesPerSide)
+    {
+        return false;
+    }
+
+    OutTile.TileX = TileX;
+    OutTile.TileY = TileY;
+    OutTile.Texels = Layout.GetTileTexels(TileX, TileY);
+
+    const int32 NumTexels = OutTile.Texels.GetWidth() * OutTile.Texels.GetHeight();
+    const FString TilePath = GetTilePath(Directory, TileX, TileY);
+
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*TilePath));
+    if (!Reader || Reader->TotalSize() != int64(NumTexels) * sizeof(uint16))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Streamed heightmap: missing or truncated tile %s"), *TilePath);
+        return false;
+    }
+
+    OutTile.HeightValues.SetNumUninitialized(NumTexels);
+    Reader->Serialize(OutTile.HeightValues.GetData(), NumTexels * sizeof(uint16));
+    return !Reader->IsError();
+}
+
+FString FSurvivalStreamedHeightmap::GetManifestPath(const FString& InDirectory)
+{
+    return InDirectory / TEXT("Heightmap.rtsmanifest");
+}
+
+FString FSurvivalStreamedHeightmap::GetTilePath(const FString& InDirectory, int32 TileX, int32 TileY)
+{
+    return InDirectory / FString::Printf(TEXT("Tile_%03d_%03d.rtsheight"), TileX, TileY);
+}
+
+FSurvivalStreamedHeightmap::FTileIterator::FTileIterator(const FSurvivalStreamedHeightmap& InHeightmap)
+    : Heightmap(InHeightmap)
+    , TileIndex(0)
+    , bValid(false)
+{
+    LoadCurrent();
+}
+
+FSurvivalStreamedHeightmap::FTileIterator& FSurvivalStreamedHeightmap::FTileIterator::operator++()
+{
+    TileIndex++;
+    LoadCurrent();
+    return *this;
+}
+
+void FSurvivalStreamedHeightmap::FTileIterator::LoadCurrent()
+{
+    const int32 NumTilesPerSide = Heightmap.GetLayout().GetNumTilesPerSide();
+    bValid = Heightmap.IsOpen() && TileIndex < Heightmap.GetLayout().GetNumTiles()
+        && Heightmap.LoadTile(TileIndex % NumTilesPerSide, TileIndex / NumTilesPerSide, Tile);
+}
\ No newline at end of file
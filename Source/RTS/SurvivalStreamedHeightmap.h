@@ -0,0 +1,105 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SurvivalTerrainTiling.h"
+
+class FSurvivalTerrainPipeline;
+struct FSurvivalTerrainRequest;
+
+// Heightmap split into square tiles of TileQuads x TileQuads quads. Neighbouring tiles share their edge
+// row and column, the way landscape components share border vertices, so a tile holds up to
+// (TileQuads + 1)^2 texels and can be imported as a landscape proxy on its own.
+struct RTS_API FSurvivalHeightmapTileLayout
+{
+    int32 Resolution;
+    int32 TileQuads;
+
+    FSurvivalHeightmapTileLayout()
+        : Resolution(0), TileQuads(0)
+    {
+    }
+
+    FSurvivalHeightmapTileLayout(int32 InResolution, int32 InTileQuads)
+        : Resolution(InResolution), TileQuads(InTileQuads)
+    {
+    }
+
+    bool IsValid() const { return Resolution >= 2 && TileQuads >= 1; }
+    int32 GetNumTilesPerSide() const { return FMath::DivideAndRoundUp(Resolution - 1, TileQuads); }
+    int32 GetNumTiles() const { return FMath::Square(GetNumTilesPerSide()); }
+
+    // Texels of tile (TileX, TileY); the last row and column of tiles may be narrower
+    FSurvivalTerrainTile GetTileTexels(int32 TileX, int32 TileY) const;
+};
+
+struct FSurvivalHeightmapTile
+{
+    int32 TileX;
+    int32 TileY;
+    FSurvivalTerrainTile Texels;
+
+    // Row-major over Texels, 0-65535 like FSurvivalHeightmapData
+    TArray<uint16> HeightValues;
+
+    FSurvivalHeightmapTile()
+        : TileX(0), TileY(0)
+    {
+    }
+};
+
+// Heightmap kept on disk as one file per tile plus a manifest, for courses whose full grid (8k-16k texels
+// a side) shouldn't be held in memory. Tiles are read back one at a time through LoadTile or a tile iterator.
+class RTS_API FSurvivalStreamedHeightmap
+{
+public:
+    FSurvivalStreamedHeightmap();
+
+    // Generates Request's elevation into Directory tile by tile. Tiles are quantized with HeightToValue
+    // (called from worker threads) and written as soon as each one is done. The manifest is written last,
+    // so an interrupted run never leaves a directory that opens.
+    static bool Generate(const FSurvivalTerrainPipeline& Pipeline, const FSurvivalTerrainRequest& Request, int32 TileQuads,
+                         const FString& Directory, TFunctionRef<uint16(float)> HeightToValue);
+
+    bool Open(const FString& InDirectory);
+    bool IsOpen() const { return Layout.IsValid(); }
+
+    const FSurvivalHeightmapTileLayout& GetLayout() const { return Layout; }
+    const FVector2D& GetWorldExtent() const { return WorldExtent; }
+    float GetMaxElevation() const { return MaxElevation; }
+
+    bool LoadTile(int32 TileX, int32 TileY, FSurvivalHeightmapTile& OutTile) const;
+
+    // Visits tiles in row-major order holding only the current one in memory:
+    //   for (FSurvivalStreamedHeightmap::FTileIterator It = Heightmap.CreateTileIterator(); It; ++It) { Process(*It); }
+    // Iteration stops early if a tile fails to load.
+    class RTS_API FTileIterator
+    {
+    public:
+        explicit FTileIterator(const FSurvivalStreamedHeightmap& InHeightmap);
+
+        FTileIterator& operator++();
+        explicit operator bool() const { return bValid; }
+
+        const FSurvivalHeightmapTile& operator*() const { return Tile; }
+        const FSurvivalHeightmapTile* operator->() const { return &Tile; }
+
+    private:
+        void LoadCurrent();
+
+        const FSurvivalStreamedHeightmap& Heightmap;
+        int32 TileIndex;
+        bool bValid;
+        FSurvivalHeightmapTile Tile;
+    };
+
+    FTileIterator CreateTileIterator() const { return FTileIterator(*this); }
+
+private:
+    static FString GetManifestPath(const FString& InDirectory);
+    static FString GetTilePath(const FString& InDirectory, int32 TileX, int32 TileY);
+
+    FString Directory;
+    FSurvivalHeightmapTileLayout Layout;
+    FVector2D WorldExtent;
+    float MaxElevation;
+};
\ No newline at end of file
@@ -0,0 +1,268 @@
+#include "SurvivalTerrainBenchmarkCommandlet.h"
+#include "SurvivalBiomeManager.h"
+#include "SurvivalTerrainPipeline.h"
+#include "SurvivalTerrainTiling.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Math/RandomStream.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace SurvivalTerrainBenchmarkConstants
+{
+    // Same 5km x 2.5km course the texture blender generates for
+    static const FVector2D CourseExtent(5000.0f, 2500.0f);
+
+    // Zones cover the course about twice over whatever their count, so texels see a similar number of zones
+    static constexpr float ZoneCoverage = 2.0f;
+
+    static constexpr int32 LayoutSeed = 1337;
+}
+
+USurvivalTerrainBenchmarkCommandlet::USurvivalTerrainBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+
+    Resolutions = { 257, 513, 1025, 2049, 4097, 8193 };
+    ZoneCounts = { 5, 50, 500, 5000 };
+    ThreadCounts = { 1, 2, 4, 0 };
+    Iterations = 3;
+    BudgetMsPerMegatexel = 0.0f;
+    BudgetMemoryMB = 0.0f;
+    MinParallelEfficiency = 0.0f;
+}
+
+int32 USurvivalTerrainBenchmarkCommandlet::Main(const FString& Params)
+{
+    TArray<int32> SweepResolutions = Resolutions;
+    TArray<int32> SweepZoneCounts = ZoneCounts;
+    TArray<int32> SweepThreadCounts = ThreadCounts;
+    ParseIntList(Params, TEXT("Resolutions="), SweepResolutions);
+    ParseIntList(Params, TEXT("Zones="), SweepZoneCounts);
+    ParseIntList(Params, TEXT("Threads="), SweepThreadCounts);
+
+    FParse::Value(*Params, TEXT("Iterations="), Iterations);
+    FParse::Value(*Params, TEXT("BudgetMsPerMegatexel="), BudgetMsPerMegatexel);
+    FParse::Value(*Params, TEXT("BudgetMemoryMB="), BudgetMemoryMB);
+    FParse::Value(*Params, TEXT("MinParallelEfficiency="), MinParallelEfficiency);
+    Iterations = FMath::Max(Iterations, 1);
+
+    FString OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"), FString::Printf(TEXT("TerrainGeneration-%s.csv"), *FDateTime::Now().ToString()));
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+    IConsoleVariable* ThreadsCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("rts.Terrain.GenerationThreads"));
+    if (!ThreadsCVar)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Terrain benchmark: rts.Terrain.GenerationThreads is not registered"));
+        return 1;
+    }
+    const int32 PreviousThreads = ThreadsCVar->GetInt();
+
+    // Parallel efficiency is measured against one thread, so that run always comes first
+    SweepThreadCounts.Remove(1);
+    SweepThreadCounts.Insert(1, 0);
+
+    UE_LOG(LogTemp, Log, TEXT("Terrain benchmark: %d resolutions x %d zone counts x %d thread counts, best of %d"),
+           SweepResolutions.Num(), SweepZoneCounts.Num(), SweepThreadCounts.Num(), Iterations);
+
+    FString Csv = TEXT("Resolution,Zones,Threads,Megatexels,HeightmapMsPerMegatexel,WeightMapMsPerMegatexel,BorderBlendMsPerMegatexel,TotalMsPerMegatexel,OutputMB,PeakProcessMB,ParallelEfficiency,WithinBudget\n");
+    int32 NumOverBudget = 0;
+
+    for (const int32 ZoneCount : SweepZoneCounts)
+    {
+        FSurvivalTerrainPipeline Pipeline;
+        Pipeline.SetBiomeZones(MakeBenchmarkZones(ZoneCount), FBox2D(ForceInit));
+
+        for (const int32 Resolution : SweepResolutions)
+        {
+            const double Megatexels = double(Resolution) * double(Resolution) / 1.0e6;
+            double SingleThreadSeconds = 0.0;
+
+            for (const int32 Threads : SweepThreadCounts)
+            {
+                ThreadsCVar->Set(Threads, ECVF_SetByCode);
+                // Requests beyond the task graph's workers (plus the calling thread) only queue behind them
+                const int32 EffectiveThreads = FMath::Min(FSurvivalTerrainTiling::GetNumGenerationThreads(), FTaskGraphInterface::Get().GetNumWorkerThreads() + 1);
+
+                const FSample Sample = RunSample(Pipeline, Resolution);
+                if (Threads == 1)
+                {
+                    SingleThreadSeconds = Sample.GetTotalSeconds();
+                }
+
+                const double TotalMsPerMegatexel = Sample.GetTotalSeconds() * 1000.0 / Megatexels;
+                const double OutputMB = double(Sample.OutputBytes) / (1024.0 * 1024.0);
+                const double PeakProcessMB = double(Sample.PeakBytes) / (1024.0 * 1024.0);
+                const double Efficiency = Sample.GetTotalSeconds() > 0.0 ? SingleThreadSeconds / (Sample.GetTotalSeconds() * EffectiveThreads) : 0.0;
+
+                bool bWithinBudget = true;
+                if (BudgetMsPerMegatexel > 0.0f && TotalMsPerMegatexel > BudgetMsPerMegatexel)
+                {
+                    UE_LOG(LogTemp, Error, TEXT("Terrain benchmark: %d^2, %d zones, %d threads takes %.1f ms/Mtexel (budget %.1f)"),
+                           Resolution, ZoneCount, EffectiveThreads, TotalMsPerMegatexel, BudgetMsPerMegatexel);
+                    bWithinBudget = false;
+                }
+                if (BudgetMemoryMB > 0.0f && PeakProcessMB > BudgetMemoryMB)
+                {
+                    UE_LOG(LogTemp, Error, TEXT("Terrain benchmark: %d^2, %d zones, %d threads peaks at %.1f MB (budget %.1f)"),
+                           Resolution, ZoneCount, EffectiveThreads, PeakProcessMB, BudgetMemoryMB);
+                    bWithinBudget = false;
+                }
+                if (MinParallelEfficiency > 0.0f && EffectiveThreads > 1 && Efficiency < MinParallelEfficiency)
+                {
+                    UE_LOG(LogTemp, Error, TEXT("Terrain benchmark: %d^2, %d zones, %d threads runs at %.2f parallel efficiency (minimum %.2f)"),
+                           Resolution, ZoneCount, EffectiveThreads, Efficiency, MinParallelEfficiency);
+                    bWithinBudget = false;
+                }
+                if (!bWithinBudget)
+                {
+                    NumOverBudget++;
+                }
+
+                const FString Row = FString::Printf(TEXT("%d,%d,%d,%.3f,%.2f,%.2f,%.2f,%.2f,%.1f,%.1f,%.3f,%d"),
+                    Resolution, ZoneCount, EffectiveThreads, Megatexels,
+                    Sample.HeightmapSeconds * 1000.0 / Megatexels, Sample.WeightMapSeconds * 1000.0 / Megatexels, Sample.BorderBlendSeconds * 1000.0 / Megatexels,
+                    TotalMsPerMegatexel, OutputMB, PeakProcessMB, Efficiency, bWithinBudget ? 1 : 0);
+                UE_LOG(LogTemp, Log, TEXT("%s"), *Row);
+                Csv += Row + TEXT("\n");
+            }
+
+            Pipeline.ResetCache();
+        }
+    }
+
+    ThreadsCVar->Set(PreviousThreads, ECVF_SetByCode);
+
+    if (!FFileHelper::SaveStringToFile(Csv, *OutputPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("Terrain benchmark: could not write %s"), *OutputPath);
+        return 1;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Terrain benchmark written to %s, %d rows over budget"), *OutputPath, NumOverBudget);
+    return NumOverBudget > 0 ? 1 : 0;
+}
+
+USurvivalTerrainBenchmarkCommandlet::FSample USurvivalTerrainBenchmarkCommandlet::RunSample(FSurvivalTerrainPipeline& Pipeline, int32 Resolution) const
+{
+    // Same requests GenerateHeightmapData and GenerateTextureWeightMaps make, minus the disk cache
+    FSurvivalTerrainRequest HeightmapRequest;
+    HeightmapRequest.Grid = FSurvivalTerrainGrid(Resolution, SurvivalTerrainBenchmarkConstants::CourseExtent);
+    HeightmapRequest.bGenerateElevation = true;
+
+    FSurvivalTerrainRequest WeightMapRequest;
+    WeightMapRequest.Grid = HeightmapRequest.Grid;
+    WeightMapRequest.bGenerateLayerWeights = true;
+    WeightMapRequest.Layers.LayerBiomes = { EBiomeType::Forest, EBiomeType::Alpine, EBiomeType::River, EBiomeType::Transition };
+
+    FSample Best;
+    int64 WorstPeakBytes = 0;
+    for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+    {
+        Pipeline.ResetCache();
+
+        // Workers report progress every few percent; sampling memory there catches scratch buffers that
+        // are gone again by the time Run returns
+        const int64 BaselineBytes = int64(FPlatformMemory::GetStats().UsedPhysical);
+        TSharedRef<std::atomic<int64>> PeakUsedBytes = MakeShared<std::atomic<int64>>(BaselineBytes);
+        auto SampleMemory = [PeakUsedBytes](float)
+        {
+            const int64 UsedBytes = int64(FPlatformMemory::GetStats().UsedPhysical);
+            int64 Peak = *PeakUsedBytes;
+            while (UsedBytes > Peak && !PeakUsedBytes->compare_exchange_weak(Peak, UsedBytes))
+            {
+            }
+        };
+        HeightmapRequest.Job = MakeShared<FSurvivalTerrainJob>();
+        HeightmapRequest.Job->OnProgress = SampleMemory;
+        WeightMapRequest.Job = MakeShared<FSurvivalTerrainJob>();
+        WeightMapRequest.Job->OnProgress = SampleMemory;
+
+        // The weight map request reuses the cached influence field, as it does in a play session
+        const FSurvivalTerrainResult Heightmap = Pipeline.Run(HeightmapRequest);
+        SampleMemory(1.0f);
+        const FSurvivalTerrainResult WeightMaps = Pipeline.Run(WeightMapRequest);
+        SampleMemory(1.0f);
+        WorstPeakBytes = FMath::Max(WorstPeakBytes, *PeakUsedBytes - BaselineBytes);
+
+        FSample Sample;
+        Sample.HeightmapSeconds = Heightmap.GetStageSeconds(ESurvivalTerrainStage::Influence) + Heightmap.GetStageSeconds(ESurvivalTerrainStage::Elevation);
+        // Altitude blending derives the slope field before weighting
+        Sample.WeightMapSeconds = WeightMaps.GetStageSeconds(ESurvivalTerrainStage::Slope) + WeightMaps.GetStageSeconds(ESurvivalTerrainStage::LayerWeights);
+        Sample.BorderBlendSeconds = WeightMaps.GetStageSeconds(ESurvivalTerrainStage::BorderBlend);
+
+        if (Heightmap.Influence.IsValid())
+        {
+            Sample.OutputBytes += Heightmap.Influence->SummedInfluence.GetAllocatedSize() + Heightmap.Influence->PeakInfluence.GetAllocatedSize() + Heightmap.Influence->AlpineCoreInfluence.GetAllocatedSize();
+        }
+        if (Heightmap.Elevation.IsValid())
+        {
+            Sample.OutputBytes += Heightmap.Elevation->Elevation.GetAllocatedSize();
+        }
+        if (WeightMaps.Slope.IsValid())
+        {
+            Sample.OutputBytes += WeightMaps.Slope->SlopeDegrees.GetAllocatedSize();
+        }
+        for (const TSharedPtr<const FSurvivalLayerWeights>& Weights : { WeightMaps.RawLayerWeights, WeightMaps.BlendedLayerWeights })
+        {
+            if (Weights.IsValid())
+            {
+                for (const TArray<uint8>& Layer : Weights->Layers)
+                {
+                    Sample.OutputBytes += Layer.GetAllocatedSize();
+                }
+                Sample.OutputBytes += Weights->PackedTexels.GetAllocatedSize();
+            }
+        }
+
+        if (Iteration == 0 || Sample.GetTotalSeconds() < Best.GetTotalSeconds())
+        {
+            Best = Sample;
+        }
+    }
+
+    Best.PeakBytes = WorstPeakBytes;
+    return Best;
+}
+
+TArray<FBiomeZone> USurvivalTerrainBenchmarkCommandlet::MakeBenchmarkZones(int32 ZoneCount)
+{
+    using namespace SurvivalTerrainBenchmarkConstants;
+
+    FRandomStream Random(LayoutSeed);
+    const float CourseArea = float(CourseExtent.X * CourseExtent.Y);
+    const float MeanRadius = FMath::Sqrt(ZoneCoverage * CourseArea / (PI * FMath::Max(ZoneCount, 1)));
+
+    TArray<FBiomeZone> Zones;
+    Zones.SetNum(ZoneCount);
+    for (FBiomeZone& Zone : Zones)
+    {
+        Zone.BiomeType = EBiomeType(Random.RandRange(0, FSurvivalTerrainPipeline::NumBiomeTypes - 1));
+        Zone.CenterLocation = FVector(Random.FRandRange(0.0f, float(CourseExtent.X)), Random.FRandRange(0.0f, float(CourseExtent.Y)), 0.0f);
+        Zone.Radius = MeanRadius * Random.FRandRange(0.75f, 1.25f);
+    }
+    return Zones;
+}
+
+void USurvivalTerrainBenchmarkCommandlet::ParseIntList(const FString& Params, const TCHAR* Key, TArray<int32>& InOutValues)
+{
+    FString Value;
+    if (!FParse::Value(*Params, Key, Value, false))
+    {
+        return;
+    }
+
+    TArray<FString> Entries;
+    Value.ParseIntoArray(Entries, TEXT("+"), true);
+
+    InOutValues.Reset();
+    for (const FString& Entry : Entries)
+    {
+        InOutValues.Add(FCString::Atoi(*Entry));
+    }
+}
\ No newline at end of file
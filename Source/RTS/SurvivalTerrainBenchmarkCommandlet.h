@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SurvivalTerrainBenchmarkCommandlet.generated.h"
+
+class FSurvivalTerrainPipeline;
+struct FBiomeZone;
+
+// Times terrain generation headless over a sweep of heightmap resolutions, biome zone counts and
+// generation thread counts, and writes one CSV row per combination. Each row reports, for the
+// heightmap (influence + elevation), weight map (layer weights) and border blend stages, the best
+// of -Iterations runs in ms per megatexel, plus stage output memory, the peak process memory growth
+// while the combination ran and parallel efficiency against the single-thread run of the same
+// resolution and zone count.
+//
+// UnrealEditor-Cmd RTS.uproject -run=SurvivalTerrainBenchmark [-Resolutions=257+1025] [-Zones=5+500]
+//     [-Threads=1+4+0] [-Iterations=3] [-Output=Saved/Benchmarks/Terrain.csv]
+//     [-BudgetMsPerMegatexel=400] [-BudgetMemoryMB=4096] [-MinParallelEfficiency=0.5]
+//
+// Thread count 0 means every task graph worker. Budgets default to the [/Script/RTS.SurvivalTerrainBenchmarkCommandlet]
+// section of DefaultGame.ini; 0 disables a budget. Returns 1 when any row exceeds a budget.
+UCLASS(Config = Game)
+class RTS_API USurvivalTerrainBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    USurvivalTerrainBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+    // Sweep used when the command line doesn't give one
+    UPROPERTY(Config)
+    TArray<int32> Resolutions;
+
+    UPROPERTY(Config)
+    TArray<int32> ZoneCounts;
+
+    UPROPERTY(Config)
+    TArray<int32> ThreadCounts;
+
+    UPROPERTY(Config)
+    int32 Iterations;
+
+    // Heightmap, weight map and border blend time together
+    UPROPERTY(Config)
+    float BudgetMsPerMegatexel;
+
+    // Peak process memory above what was in use before a combination started
+    UPROPERTY(Config)
+    float BudgetMemoryMB;
+
+    // Only checked for rows with more than one thread
+    UPROPERTY(Config)
+    float MinParallelEfficiency;
+
+private:
+    struct FSample
+    {
+        double HeightmapSeconds;
+        double WeightMapSeconds;
+        double BorderBlendSeconds;
+        int64 OutputBytes;
+        // Largest UsedPhysical seen during any iteration, less the baseline taken before it
+        int64 PeakBytes;
+
+        FSample()
+            : HeightmapSeconds(0.0), WeightMapSeconds(0.0), BorderBlendSeconds(0.0), OutputBytes(0), PeakBytes(0)
+        {
+        }
+
+        double GetTotalSeconds() const { return HeightmapSeconds + WeightMapSeconds + BorderBlendSeconds; }
+    };
+
+    // Best of Iterations cold runs (stage caches cleared before each); PeakBytes is the worst of them
+    FSample RunSample(FSurvivalTerrainPipeline& Pipeline, int32 Resolution) const;
+
+    // Deterministic layout of ZoneCount zones over the course, sized so their total area stays about the same
+    static TArray<FBiomeZone> MakeBenchmarkZones(int32 ZoneCount);
+
+    static void ParseIntList(const FString& Params, const TCHAR* Key, TArray<int32>& InOutValues);
+};
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include "SurvivalTerrainCacheCommandlet.h"
+#include "SurvivalBiomeManager.h"
+#include "SurvivalLandscapeManager.h"
+#include "SurvivalLandscapeTextureBlender.h"
+#include "SurvivalTerrainDiskCache.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+USurvivalTerrainCacheCommandlet::USurvivalTerrainCacheCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 USurvivalTerrainCacheCommandlet::Main(const FString& Params)
+{
+    if (!FSurvivalTerrainDiskCache::IsEnabled())
+    {
+        UE_LOG(LogTemp, Error, TEXT("Terrain disk cache is disabled (rts.Terrain.DiskCache 0), nothing to populate"));
+        return 1;
+    }
+    
+    TArray<FString> MapPackages;
+    FString MapsParam;
+    if (FParse::Value(*Params, TEXT("Maps="), MapsParam, false))
+    {
+        MapsParam.ParseIntoArray(MapPackages, TEXT("+"), true);
+    }
+    else
+    {
+        MapPackages = FindAllMapPackages();
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("Populating terrain cache in %s for %d maps"), *FSurvivalTerrainDiskCache::GetCacheDirectory(), MapPackages.Num());
+    
+    int32 NumFailed = 0;
+    for (const FString& MapPackage : MapPackages)
+    {
+        if (!PopulateMap(MapPackage))
+        {
+            NumFailed++;
+        }
+        
+        // Each map's actors and generated buffers are released before the next one loads
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    }
+    
+    // Stores are written in the background; the process must not exit before they land
+    FSurvivalTerrainDiskCache::FlushPendingStores();
+    
+    UE_LOG(LogTemp, Log, TEXT("Terrain cache populated: %d maps, %d failed"), MapPackages.Num(), NumFailed);
+    return NumFailed > 0 ? 1 : 0;
+}
+
+TArray<FString> USurvivalTerrainCacheCommandlet::FindAllMapPackages() const
+{
+    TArray<FString> MapFiles;
+    IFileManager::Get().FindFilesRecursive(MapFiles, *FPaths::ProjectContentDir(), *(TEXT("*") + FPackageName::GetMapPackageExtension()), true, false);
+    
+    TArray<FString> MapPackages;
+    for (const FString& MapFile : MapFiles)
+    {
+        FString PackageName;
+        if (FPackageName::TryConvertFilenameToLongPackageName(MapFile, PackageName))
+        {
+            MapPackages.Add(PackageName);
+        }
+    }
+    return MapPackages;
+}
+
+bool USurvivalTerrainCacheCommandlet::PopulateMap(const FString& MapPackageName)
+{
+    UPackage* Package = LoadPackage(nullptr, *MapPackageName, LOAD_None);
+    UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+    if (!World || !World->PersistentLevel)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Could not load map %s"), *MapPackageName);
+        return false;
+    }
+    
+    TArray<ASurvivalBiomeManager*> BiomeManagers;
+    TArray<ASurvivalLandscapeManager*> LandscapeManagers;
+    TArray<ASurvivalLandscapeTextureBlender*> TextureBlenders;
+    for (AActor* Actor : World->PersistentLevel->Actors)
+    {
+        if (ASurvivalBiomeManager* BiomeManager = Cast<ASurvivalBiomeManager>(Actor))
+        {
+            BiomeManagers.Add(BiomeManager);
+        }
+        else if (ASurvivalLandscapeManager* LandscapeManager = Cast<ASurvivalLandscapeManager>(Actor))
+        {
+            LandscapeManagers.Add(LandscapeManager);
+        }
+        else if (ASurvivalLandscapeTextureBlender* TextureBlender = Cast<ASurvivalLandscapeTextureBlender>(Actor))
+        {
+            TextureBlenders.Add(TextureBlender);
+        }
+    }
+    
+    // Maps without a biome manager don't define a course
+    if (BiomeManagers.Num() == 0)
+    {
+        return true;
+    }
+    
+    for (ASurvivalBiomeManager* BiomeManager : BiomeManagers)
+    {
+        BiomeManager->PopulateTerrainCache();
+    }
+    
+    // Same fallback as BeginPlay's auto-find: the first biome manager in the level
+    for (ASurvivalLandscapeManager* LandscapeManager : LandscapeManagers)
+    {
+        LandscapeManager->PopulateTerrainCache(BiomeManagers[0]);
+    }
+    
+    for (ASurvivalLandscapeTextureBlender* TextureBlender : TextureBlenders)
+    {
+        TextureBlender->PopulateTerrainCache(BiomeManagers[0]);
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("Cached terrain for %s (%d biome managers, %d landscape managers, %d texture blenders)"),
+           *MapPackageName, BiomeManagers.Num(), LandscapeManagers.Num(), TextureBlenders.Num());
+    return true;
+}
\ No newline at end of file
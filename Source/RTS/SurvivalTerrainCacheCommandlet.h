@@ -0,0 +1,28 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SurvivalTerrainCacheCommandlet.generated.h"
+
+// Fills Saved/TerrainCache for every course (a map with a biome manager) so the first play session
+// loads its heightmaps and weight maps instead of generating them.
+//
+// UnrealEditor-Cmd RTS.uproject -run=SurvivalTerrainCache [-Maps=/Game/Maps/RaceA+/Game/Maps/RaceB]
+//
+// Without -Maps every map under the project content directory is visited.
+UCLASS()
+class RTS_API USurvivalTerrainCacheCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    USurvivalTerrainCacheCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+private:
+    TArray<FString> FindAllMapPackages() const;
+
+    // Returns false when the map could not be loaded
+    bool PopulateMap(const FString& MapPackageName);
+};
\ No newline at end of file
@@ -0,0 +1,285 @@
+#include "SurvivalTerrainDiskCache.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Hash/xxhash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Tasks/Pipe.h"
+
+static TAutoConsoleVariable<int32> CVarTerrainDiskCache(
+    TEXT("rts.Terrain.DiskCache"),
+    1,
+    TEXT("Load and store generated heightmaps and weight maps under Saved/TerrainCache.\n")
+    TEXT(" 0: always generate\n")
+    TEXT(" 1: use the disk cache (default)"),
+    ECVF_Default);
+
+namespace SurvivalTerrainDiskCacheFormat
+{
+    constexpr uint32 Magic = 0x43535452; // 'RTSC'
+
+    // Bump when the file layout changes
+    constexpr uint32 FormatVersion = 2;
+
+    constexpr int32 MaxCachedFiles = 64;
+
+    // Written as-is at the start of every file; the cache never leaves the machine that wrote it
+    struct FHeader
+    {
+        uint32 Magic;
+        uint32 FormatVersion;
+        uint64 Key;
+        uint64 PayloadHash;
+        uint32 ElementSize;
+        uint32 Reserved;
+        int64 NumElements;
+    };
+    static_assert(sizeof(FHeader) == 40, "Header layout must not contain padding");
+
+    // Serializes stores, so two writes of one key or a prune never overlap a write
+    UE::Tasks::FPipe& GetStorePipe()
+    {
+        static UE::Tasks::FPipe StorePipe(TEXT("SurvivalTerrainDiskCache"));
+        return StorePipe;
+    }
+
+    // Validates the header and decodes the compressed grid out of a mapped or loaded file
+    bool ReadPayload(const uint8* FileData, int64 FileSize, uint64 Key, uint32 ElementSize, int64 NumElements, FSurvivalCompressedTerrainGrid& OutGrid)
+    {
+        if (FileSize < int64(sizeof(FHeader)))
+        {
+            return false;
+        }
+        const int64 PayloadSize = FileSize - sizeof(FHeader);
+
+        FHeader Header;
+        FMemory::Memcpy(&Header, FileData, sizeof(FHeader));
+
+        if (Header.Magic != Magic || Header.FormatVersion != FormatVersion || Header.Key != Key
+            || Header.ElementSize != ElementSize || Header.NumElements != NumElements)
+        {
+            return false;
+        }
+
+        const uint8* Payload = FileData + sizeof(FHeader);
+        if (FXxHash64::HashBuffer(Payload, PayloadSize).Hash != Header.PayloadHash)
+        {
+            return false; // Truncated or corrupted write
+        }
+
+        FMemoryReaderView Reader(MakeArrayView(Payload, PayloadSize));
+        OutGrid.Serialize(Reader);
+        return !Reader.IsError() && OutGrid.GetBytesPerValue() == int32(ElementSize)
+            && int64(OutGrid.GetWidth()) * OutGrid.GetHeight() == NumElements;
+    }
+}
+
+bool FSurvivalTerrainDiskCache::IsEnabled()
+{
+    return CVarTerrainDiskCache.GetValueOnAnyThread() != 0;
+}
+
+uint64 FSurvivalTerrainDiskCache::MakeKey(uint64 StageHash, const TCHAR* Consumer)
+{
+    FXxHash64Builder Builder;
+    Builder.Update(&StageHash, sizeof(StageHash));
+    Builder.Update(Consumer, FCString::Strlen(Consumer) * sizeof(TCHAR));
+    return Builder.Finalize().Hash;
+}
+
+FString FSurvivalTerrainDiskCache::GetCacheDirectory()
+{
+    return FPaths::ProjectSavedDir() / TEXT("TerrainCache");
+}
+
+bool FSurvivalTerrainDiskCache::LoadHeights(uint64 Key, int32 Width, int32 NumValues, TArray<uint16>& OutHeights)
+{
+    if (!Load(Key, sizeof(uint16), NumValues, [&OutHeights, Width](const FSurvivalCompressedTerrainGrid& Grid) { return Grid.GetWidth() == Width && Grid.Decompress(OutHeights); }))
+    {
+        OutHeights.Reset();
+        return false;
+    }
+    return true;
+}
+
+bool FSurvivalTerrainDiskCache::LoadWeights(uint64 Key, int32 Width, int32 NumValues, TArray<uint8>& OutWeights)
+{
+    if (!Load(Key, sizeof(uint8), NumValues, [&OutWeights, Width](const FSurvivalCompressedTerrainGrid& Grid) { return Grid.GetWidth() == Width && Grid.Decompress(OutWeights); }))
+    {
+        OutWeights.Reset();
+        return false;
+    }
+    return true;
+}
+
+void FSurvivalTerrainDiskCache::StoreHeights(uint64 Key, int32 Width, const TArray<uint16>& Heights)
+{
+    if (!IsEnabled() || Width <= 0 || Heights.Num() % Width != 0)
+    {
+        return;
+    }
+
+    SurvivalTerrainDiskCacheFormat::GetStorePipe().Launch(UE_SOURCE_LOCATION, [Key, Width, Heights]()
+    {
+        FSurvivalCompressedTerrainGrid Grid;
+        Grid.Compress(Heights, Width, Heights.Num() / Width);
+        Store(Key, sizeof(uint16), Heights.Num(), Grid);
+    });
+}
+
+void FSurvivalTerrainDiskCache::StoreWeights(uint64 Key, int32 Width, const TArray<uint8>& Weights)
+{
+    if (!IsEnabled() || Width <= 0 || Weights.Num() % Width != 0)
+    {
+        return;
+    }
+
+    SurvivalTerrainDiskCacheFormat::GetStorePipe().Launch(UE_SOURCE_LOCATION, [Key, Width, Weights]()
+    {
+        FSurvivalCompressedTerrainGrid Grid;
+        Grid.Compress(Weights, Width, Weights.Num() / Width);
+        Store(Key, sizeof(uint8), Weights.Num(), Grid);
+    });
+}
+
+void FSurvivalTerrainDiskCache::FlushPendingStores()
+{
+    SurvivalTerrainDiskCacheFormat::GetStorePipe().WaitUntilEmpty();
+}
+
+bool FSurvivalTerrainDiskCache::Load(uint64 Key, uint32 ElementSize, int64 NumElements, TFunctionRef<bool(const FSurvivalCompressedTerrainGrid&)> ReadGrid)
+{
+    using namespace SurvivalTerrainDiskCacheFormat;
+
+    if (!IsEnabled() || NumElements <= 0)
+    {
+        return false;
+    }
+
+    const FString Path = GetCacheDirectory() / FString::Printf(TEXT("%016llx.rtsterrain"), Key);
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    if (!PlatformFile.FileExists(*Path))
+    {
+        return false;
+    }
+
+    bool bLoaded = false;
+    FSurvivalCompressedTerrainGrid Grid;
+
+    FOpenMappedResult MappedFile = PlatformFile.OpenMappedEx(*Path);
+    if (MappedFile.HasValue())
+    {
+        TUniquePtr<IMappedFileHandle> MappedHandle = MappedFile.StealValue();
+        TUniquePtr<IMappedFileRegion> MappedRegion(MappedHandle->MapRegion(0, MappedHandle->GetFileSize()));
+        if (MappedRegion)
+        {
+            bLoaded = ReadPayload(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize(), Key, ElementSize, NumElements, Grid);
+        }
+    }
+    else
+    {
+        // Platforms without file mapping fall back to a plain read
+        TArray64<uint8> FileData;
+        if (FFileHelper::LoadFileToArray(FileData, *Path))
+        {
+            bLoaded = ReadPayload(FileData.GetData(), FileData.Num(), Key, ElementSize, NumElements, Grid);
+        }
+    }
+
+    // The mapping is closed by now; only the compressed tiles were copied out of it
+    bLoaded = bLoaded && ReadGrid(Grid);
+
+    if (!bLoaded)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Discarding stale or corrupt terrain cache file %s"), *Path);
+        IFileManager::Get().Delete(*Path, false, false, true);
+        return false;
+    }
+
+    // Pruning removes the least recently used files first
+    IFileManager::Get().SetTimeStamp(*Path, FDateTime::UtcNow());
+    return true;
+}
+
+void FSurvivalTerrainDiskCache::Store(uint64 Key, uint32 ElementSize, int64 NumElements, FSurvivalCompressedTerrainGrid& Grid)
+{
+    using namespace SurvivalTerrainDiskCacheFormat;
+
+    if (!IsEnabled() || NumElements <= 0)
+    {
+        return;
+    }
+
+    TArray<uint8> Payload;
+    FMemoryWriter PayloadWriter(Payload);
+    Grid.Serialize(PayloadWriter);
+    const int64 PayloadSize = Payload.Num();
+    const void* Data = Payload.GetData();
+
+    FHeader Header;
+    Header.Magic = Magic;
+    Header.FormatVersion = FormatVersion;
+    Header.Key = Key;
+    Header.PayloadHash = FXxHash64::HashBuffer(Data, PayloadSize).Hash;
+    Header.ElementSize = ElementSize;
+    Header.Reserved = 0;
+    Header.NumElements = NumElements;
+
+    // Write to a temporary name and rename, so a reader never maps a half-written file
+    const FString Path = GetCacheDirectory() / FString::Printf(TEXT("%016llx.rtsterrain"), Key);
+    const FString TempPath = Path + TEXT(".tmp");
+
+    TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempPath));
+    if (!Writer)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Could not write terrain cache file %s"), *TempPath);
+        return;
+    }
+
+    Writer->Serialize(&Header, sizeof(Header));
+    Writer->Serialize(const_cast<void*>(Data), PayloadSize);
+    const bool bWritten = Writer->Close() && !Writer->IsError();
+    Writer.Reset();
+
+    if (!bWritten || !IFileManager::Get().Move(*Path, *TempPath, true, true))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Could not write terrain cache file %s"), *Path);
+        IFileManager::Get().Delete(*TempPath, false, false, true);
+        return;
+    }
+
+    PruneCacheDirectory();
+}
+
+void FSurvivalTerrainDiskCache::PruneCacheDirectory()
+{
+    using namespace SurvivalTerrainDiskCacheFormat;
+
+    const FString Directory = GetCacheDirectory();
+    TArray<FString> FileNames;
+    IFileManager::Get().FindFiles(FileNames, *(Directory / TEXT("*.rtsterrain")), true, false);
+
+    if (FileNames.Num() <= MaxCachedFiles)
+    {
+        return;
+    }
+
+    TArray<TPair<FDateTime, FString>> Files;
+    for (const FString& FileName : FileNames)
+    {
+        const FString Path = Directory / FileName;
+        Files.Emplace(IFileManager::Get().GetTimeStamp(*Path), Path);
+    }
+
+    // Oldest first
+    Files.Sort([](const TPair<FDateTime, FString>& A, const TPair<FDateTime, FString>& B) { return A.Key < B.Key; });
+
+    for (int32 FileIndex = 0; FileIndex < Files.Num() - MaxCachedFiles; FileIndex++)
+    {
+        IFileManager::Get().Delete(*Files[FileIndex].Value, false, false, true);
+    }
+}
\ No newline at end of file
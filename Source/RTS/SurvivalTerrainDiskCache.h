@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SurvivalCompressedTerrainGrid.h"
+
+// Derived terrain buffers (heightmaps, weight layers) persisted under Saved/TerrainCache, one
+// versioned file per key. Keys come from FSurvivalTerrainPipeline::GetStageHash, so a file can
+// only match the exact zones and settings it was generated from. Buffers are stored as
+// FSurvivalCompressedTerrainGrid rows of Width values and decoded straight out of a memory mapping.
+// Disabled with rts.Terrain.DiskCache 0.
+struct RTS_API FSurvivalTerrainDiskCache
+{
+    static bool IsEnabled();
+
+    // Combines a pipeline stage hash with the consumer that converted it, since the biome manager
+    // and landscape manager quantize the same elevation differently
+    static uint64 MakeKey(uint64 StageHash, const TCHAR* Consumer);
+
+    // NumValues must be a multiple of Width; stacked weight layers are stored as one tall grid
+    static bool LoadHeights(uint64 Key, int32 Width, int32 NumValues, TArray<uint16>& OutHeights);
+    static bool LoadWeights(uint64 Key, int32 Width, int32 NumValues, TArray<uint8>& OutWeights);
+
+    // Copy the buffer and return; compression, the write and pruning run one store at a time off the game thread
+    static void StoreHeights(uint64 Key, int32 Width, const TArray<uint16>& Heights);
+    static void StoreWeights(uint64 Key, int32 Width, const TArray<uint8>& Weights);
+
+    // Blocks until every queued store is on disk
+    static void FlushPendingStores();
+
+    static FString GetCacheDirectory();
+
+private:
+    // Header checks and the grid decode are left to the caller, which knows the value type
+    static bool Load(uint64 Key, uint32 ElementSize, int64 NumElements, TFunctionRef<bool(const FSurvivalCompressedTerrainGrid&)> ReadGrid);
+    static void Store(uint64 Key, uint32 ElementSize, int64 NumElements, FSurvivalCompressedTerrainGrid& Grid);
+
+    // Keeps the directory from growing without bound as courses and settings change
+    static void PruneCacheDirectory();
+};
\ No newline at end of file
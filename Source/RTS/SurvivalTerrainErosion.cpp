@@ -0,0 +1,306 @@
+#include "SurvivalTerrainErosion.h"
+#include "SurvivalTerrainPipeline.h"
+#include "SurvivalTerrainTiling.h"
+#include "Hash/xxhash.h"
+
+namespace SurvivalTerrainErosionConstants
+{
+    // Neighbour order of every stencil: -X, +X, -Y, +Y. Index ^ 1 is the opposite direction.
+    constexpr int32 NumNeighbours = 4;
+    constexpr int32 OffsetX[NumNeighbours] = { -1, 1, 0, 0 };
+    constexpr int32 OffsetY[NumNeighbours] = { 0, 0, -1, 1 };
+
+    // Each pair exchanges at most half its excess, split over four neighbours, so no texel can overshoot
+    constexpr float PairShare = 0.125f;
+
+    // Water below this depth neither flows nor carries sediment
+    constexpr float MinWater = 1.0e-4f;
+
+    // Bump when the erosion model changes, so cached eroded heightmaps are regenerated
+    constexpr uint32 ErosionVersion = 1;
+
+    template<typename ValueType>
+    void AppendHash(FXxHash64Builder& Builder, const ValueType& Value)
+    {
+        Builder.Update(&Value, sizeof(ValueType));
+    }
+
+    // Fields of the hydraulic model, one float per texel
+    struct FHydraulicState
+    {
+        TArray<float> Terrain;
+        TArray<float> Water;
+        TArray<float> Sediment;
+
+        void SetNum(int32 NumTexels)
+        {
+            Terrain.SetNumUninitialized(NumTexels);
+            Water.SetNumZeroed(NumTexels);
+            Sediment.SetNumZeroed(NumTexels);
+        }
+    };
+
+    void ThermalStep(const FSurvivalTerrainTile& Tile, int32 Width, int32 Height, const float Talus[NumNeighbours], float Rate, const float* Source, float* Dest)
+    {
+        for (int32 Y = Tile.MinY; Y < Tile.MaxY; Y++)
+        {
+            for (int32 X = Tile.MinX; X < Tile.MaxX; X++)
+            {
+                const int32 Index = Y * Width + X;
+                const float Center = Source[Index];
+                float Change = 0.0f;
+
+                for (int32 Neighbour = 0; Neighbour < NumNeighbours; Neighbour++)
+                {
+                    const int32 NX = X + OffsetX[Neighbour];
+                    const int32 NY = Y + OffsetY[Neighbour];
+                    if (NX < 0 || NY < 0 || NX >= Width || NY >= Height)
+                    {
+                        continue; // Closed boundary
+                    }
+
+                    // Same expression from both sides of the pair with the sign flipped, so mass is conserved
+                    const float Difference = Center - Source[NY * Width + NX];
+                    const float Excess = FMath::Abs(Difference) - Talus[Neighbour];
+                    if (Excess > 0.0f)
+                    {
+                        Change -= FMath::Sign(Difference) * Excess * Rate * PairShare;
+                    }
+                }
+
+                Dest[Index] = Center + Change;
+            }
+        }
+    }
+
+    // Pass 1: rain, then each texel's water outflow to its lower neighbours, limited to the water it holds
+    void HydraulicFlowStep(const FSurvivalTerrainTile& Tile, int32 Width, int32 Height, const FSurvivalTerrainErosionSettings& Settings,
+                           const FHydraulicState& State, float* Outflow)
+    {
+        for (int32 Y = Tile.MinY; Y < Tile.MaxY; Y++)
+        {
+            for (int32 X = Tile.MinX; X < Tile.MaxX; X++)
+            {
+                const int32 Index = Y * Width + X;
+                const float Water = State.Water[Index] + Settings.RainAmount;
+                const float Surface = State.Terrain[Index] + Water;
+
+                float Drop[NumNeighbours];
+                float TotalDrop = 0.0f;
+                for (int32 Neighbour = 0; Neighbour < NumNeighbours; Neighbour++)
+                {
+                    const int32 NX = X + OffsetX[Neighbour];
+                    const int32 NY = Y + OffsetY[Neighbour];
+                    Drop[Neighbour] = 0.0f;
+                    if (NX >= 0 && NY >= 0 && NX < Width && NY < Height)
+                    {
+                        const int32 NeighbourIndex = NY * Width + NX;
+                        const float NeighbourWater = State.Water[NeighbourIndex] + Settings.RainAmount;
+                        Drop[Neighbour] = FMath::Max(Surface - (State.Terrain[NeighbourIndex] + NeighbourWater), 0.0f);
+                    }
+                    TotalDrop += Drop[Neighbour];
+                }
+
+                // Moving half the total drop levels a texel with its neighbours without sloshing past them
+                const float TotalOut = Water > MinWater && TotalDrop > 0.0f ? FMath::Min(Water, 0.5f * TotalDrop) : 0.0f;
+                for (int32 Neighbour = 0; Neighbour < NumNeighbours; Neighbour++)
+                {
+                    Outflow[Index * NumNeighbours + Neighbour] = TotalOut > 0.0f ? TotalOut * Drop[Neighbour] / TotalDrop : 0.0f;
+                }
+            }
+        }
+    }
+
+    // Pass 2: gather the neighbours' outflow, move sediment with the water, then erode or deposit
+    void HydraulicTransportStep(const FSurvivalTerrainTile& Tile, int32 Width, int32 Height, const FSurvivalTerrainErosionSettings& Settings,
+                                const FHydraulicState& State, const float* Outflow, FHydraulicState& NewState)
+    {
+        for (int32 Y = Tile.MinY; Y < Tile.MaxY; Y++)
+        {
+            for (int32 X = Tile.MinX; X < Tile.MaxX; X++)
+            {
+                const int32 Index = Y * Width + X;
+                const float Water = State.Water[Index] + Settings.RainAmount;
+
+                float TotalOut = 0.0f;
+                for (int32 Neighbour = 0; Neighbour < NumNeighbours; Neighbour++)
+                {
+                    TotalOut += Outflow[Index * NumNeighbours + Neighbour];
+                }
+
+                // Sediment leaves in proportion to the water that leaves
+                float Sediment = State.Sediment[Index] * (Water > 0.0f ? 1.0f - TotalOut / Water : 1.0f);
+                float Inflow = 0.0f;
+                for (int32 Neighbour = 0; Neighbour < NumNeighbours; Neighbour++)
+                {
+                    const int32 NX = X + OffsetX[Neighbour];
+                    const int32 NY = Y + OffsetY[Neighbour];
+                    if (NX < 0 || NY < 0 || NX >= Width || NY >= Height)
+                    {
+                        continue;
+                    }
+
+                    const int32 NeighbourIndex = NY * Width + NX;
+                    const float NeighbourFlow = Outflow[NeighbourIndex * NumNeighbours + (Neighbour ^ 1)];
+                    if (NeighbourFlow > 0.0f)
+                    {
+                        const float NeighbourWater = State.Water[NeighbourIndex] + Settings.RainAmount;
+                        Inflow += NeighbourFlow;
+                        Sediment += State.Sediment[NeighbourIndex] * NeighbourFlow / NeighbourWater;
+                    }
+                }
+
+                float Terrain = State.Terrain[Index];
+                const float Capacity = Settings.SedimentCapacity * 0.5f * (TotalOut + Inflow);
+                if (Sediment > Capacity)
+                {
+                    const float Deposited = Settings.DepositionRate * (Sediment - Capacity);
+                    Terrain += Deposited;
+                    Sediment -= Deposited;
+                }
+                else
+                {
+                    const float Eroded = FMath::Min(Settings.ErosionRate * (Capacity - Sediment), Terrain);
+                    Terrain -= Eroded;
+                    Sediment += Eroded;
+                }
+
+                NewState.Terrain[Index] = Terrain;
+                NewState.Water[Index] = (Water - TotalOut + Inflow) * (1.0f - Settings.EvaporationRate);
+                NewState.Sediment[Index] = Sediment;
+            }
+        }
+    }
+}
+
+bool FSurvivalTerrainErosion::Erode(TArray<uint16>& Heights, int32 Width, int32 Height, const FVector2D& TexelSize, float MaxElevation,
+                                    const FSurvivalTerrainErosionSettings& Settings, int32 TileSize, const FSurvivalTerrainJob* Job)
+{
+    using namespace SurvivalTerrainErosionConstants;
+
+    if (!Settings.IsEnabled() || Width < 2 || Height < 2 || Heights.Num() != Width * Height || MaxElevation <= 0.0f)
+    {
+        return true;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    const int32 NumTexels = Width * Height;
+    const float HeightScale = MaxElevation / 65535.0f;
+
+    TArray<FSurvivalTerrainTile> Tiles;
+    FSurvivalTerrainTiling::BuildTiles(Width, Height, FMath::Max(TileSize, 8), Tiles);
+
+    // Erode in world units so the talus angle and rain amount mean the same thing at every resolution
+    TArray<float> Terrain;
+    Terrain.SetNumUninitialized(NumTexels);
+    for (int32 Index = 0; Index < NumTexels; Index++)
+    {
+        Terrain[Index] = Heights[Index] * HeightScale;
+    }
+
+    if (Settings.bThermal)
+    {
+        const float TalusSlope = FMath::Tan(FMath::DegreesToRadians(FMath::Clamp(Settings.TalusAngleDegrees, 0.0f, 89.0f)));
+        const float Talus[NumNeighbours] = {
+            float(TexelSize.X) * TalusSlope, float(TexelSize.X) * TalusSlope,
+            float(TexelSize.Y) * TalusSlope, float(TexelSize.Y) * TalusSlope
+        };
+        const float Rate = FMath::Clamp(Settings.ThermalRate, 0.0f, 1.0f);
+
+        TArray<float> Scratch;
+        Scratch.SetNumUninitialized(NumTexels);
+        for (int32 Iteration = 0; Iteration < Settings.ThermalIterations; Iteration++)
+        {
+            if (Job && Job->IsCancelled())
+            {
+                return false;
+            }
+
+            FSurvivalTerrainTiling::ParallelForEachTile(Tiles, [&](const FSurvivalTerrainTile& Tile)
+            {
+                ThermalStep(Tile, Width, Height, Talus, Rate, Terrain.GetData(), Scratch.GetData());
+            });
+            Swap(Terrain, Scratch);
+        }
+    }
+
+    if (Settings.bHydraulic)
+    {
+        FHydraulicState State;
+        FHydraulicState NewState;
+        State.SetNum(NumTexels);
+        NewState.SetNum(NumTexels);
+        State.Terrain = MoveTemp(Terrain);
+
+        TArray<float> Outflow;
+        Outflow.SetNumUninitialized(NumTexels * NumNeighbours);
+
+        for (int32 Iteration = 0; Iteration < Settings.HydraulicIterations; Iteration++)
+        {
+            if (Job && Job->IsCancelled())
+            {
+                return false;
+            }
+
+            // The barrier between the passes is the halo exchange: transport reads the neighbours' outflow
+            FSurvivalTerrainTiling::ParallelForEachTile(Tiles, [&](const FSurvivalTerrainTile& Tile)
+            {
+                HydraulicFlowStep(Tile, Width, Height, Settings, State, Outflow.GetData());
+            });
+            FSurvivalTerrainTiling::ParallelForEachTile(Tiles, [&](const FSurvivalTerrainTile& Tile)
+            {
+                HydraulicTransportStep(Tile, Width, Height, Settings, State, Outflow.GetData(), NewState);
+            });
+            Swap(State, NewState);
+        }
+
+        // Whatever the water still carries settles where it is
+        Terrain = MoveTemp(State.Terrain);
+        for (int32 Index = 0; Index < NumTexels; Index++)
+        {
+            Terrain[Index] += State.Sediment[Index];
+        }
+    }
+
+    for (int32 Index = 0; Index < NumTexels; Index++)
+    {
+        Heights[Index] = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(Terrain[Index] / HeightScale), 0, 65535));
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Eroded %dx%d heightmap (%d thermal, %d hydraulic iterations) in %.2fs"),
+           Width, Height, Settings.bThermal ? Settings.ThermalIterations : 0, Settings.bHydraulic ? Settings.HydraulicIterations : 0,
+           FPlatformTime::Seconds() - StartTime);
+    return true;
+}
+
+uint64 FSurvivalTerrainErosion::ChainHash(uint64 UpstreamHash, const FSurvivalTerrainErosionSettings& Settings)
+{
+    using namespace SurvivalTerrainErosionConstants;
+
+    if (!Settings.IsEnabled())
+    {
+        return UpstreamHash;
+    }
+
+    FXxHash64Builder Builder;
+    AppendHash(Builder, UpstreamHash);
+    AppendHash(Builder, ErosionVersion);
+    AppendHash(Builder, Settings.bThermal);
+    if (Settings.bThermal)
+    {
+        AppendHash(Builder, Settings.ThermalIterations);
+        AppendHash(Builder, Settings.TalusAngleDegrees);
+        AppendHash(Builder, Settings.ThermalRate);
+    }
+    AppendHash(Builder, Settings.bHydraulic);
+    if (Settings.bHydraulic)
+    {
+        AppendHash(Builder, Settings.HydraulicIterations);
+        AppendHash(Builder, Settings.RainAmount);
+        AppendHash(Builder, Settings.SedimentCapacity);
+        AppendHash(Builder, Settings.ErosionRate);
+        AppendHash(Builder, Settings.DepositionRate);
+        AppendHash(Builder, Settings.EvaporationRate);
+    }
+    return Builder.Finalize().Hash;
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FSurvivalTerrainJob;
+
+struct FSurvivalTerrainErosionSettings
+{
+    // Material on slopes steeper than TalusAngleDegrees slides down to its lower neighbours
+    bool bThermal;
+    int32 ThermalIterations;
+    float TalusAngleDegrees;
+
+    // Fraction of the height above the talus slope moved per iteration (0-1)
+    float ThermalRate;
+
+    // Grid-based water and sediment transport: rain, downhill flow, erosion where the flow can carry more
+    // sediment than it holds, deposition where it can carry less, evaporation
+    bool bHydraulic;
+    int32 HydraulicIterations;
+
+    // World height units of water added to every texel per iteration
+    float RainAmount;
+
+    // Sediment a unit of flowing water can carry
+    float SedimentCapacity;
+    float ErosionRate;
+    float DepositionRate;
+    float EvaporationRate;
+
+    FSurvivalTerrainErosionSettings()
+        : bThermal(false)
+        , ThermalIterations(40)
+        , TalusAngleDegrees(35.0f)
+        , ThermalRate(0.5f)
+        , bHydraulic(false)
+        , HydraulicIterations(60)
+        , RainAmount(0.5f)
+        , SedimentCapacity(0.5f)
+        , ErosionRate(0.3f)
+        , DepositionRate(0.3f)
+        , EvaporationRate(0.05f)
+    {
+    }
+
+    bool IsEnabled() const { return (bThermal && ThermalIterations > 0) || (bHydraulic && HydraulicIterations > 0); }
+};
+
+// Erosion over a finished 0-65535 heightmap. Every iteration is a 4-neighbour stencil: tiles are processed
+// in parallel reading their one-texel halo from the previous iteration's buffers and writing only their own
+// texels, with a barrier between iterations. All exchanges between texels are pairwise and summed in a
+// fixed neighbour order, so the result is bit-identical for any tile size or thread count and seeded
+// courses stay reproducible.
+struct RTS_API FSurvivalTerrainErosion
+{
+    // TexelSize is the world spacing of the grid, MaxElevation the world height of 65535. Returns false
+    // (leaving Heights untouched) when Job is cancelled.
+    static bool Erode(TArray<uint16>& Heights, int32 Width, int32 Height, const FVector2D& TexelSize, float MaxElevation,
+                      const FSurvivalTerrainErosionSettings& Settings, int32 TileSize, const FSurvivalTerrainJob* Job = nullptr);
+
+    // UpstreamHash extended by the settings; unchanged when erosion is disabled, so uneroded cache keys stay valid
+    static uint64 ChainHash(uint64 UpstreamHash, const FSurvivalTerrainErosionSettings& Settings);
+};
\ No newline at end of file
@@ -0,0 +1,587 @@
+#include "SurvivalTerrainKernels.h"
+#include "Math/VectorRegister.h"
+#include "Math/RandomStream.h"
+#include "HAL/IConsoleManager.h"
+
+// Clients rebuild the server's terrain from the replicated seed, so every operation here has to round the same
+// way on every compiler and CPU: no fused multiply-adds, no reassociation. This also keeps the scalar kernels
+// bit-identical to the vector ones, which never fuse.
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(_MSC_VER)
+#pragma float_control(precise, on)
+#pragma fp_contract(off)
+#endif
+
+static TAutoConsoleVariable<int32> CVarTerrainVectorKernels(
+    TEXT("rts.Terrain.VectorKernels"),
+    1,
+    TEXT("Use the 4-wide vector kernels for terrain noise and biome influence. Both paths give identical results.\n")
+    TEXT(" 0: scalar reference kernels\n")
+    TEXT(" 1: vector kernels (default)"),
+    ECVF_Default);
+
+static FAutoConsoleCommand CmdTerrainVerifyKernels(
+    TEXT("rts.Terrain.VerifyKernels"),
+    TEXT("Compares the vector terrain kernels against the scalar reference and logs the largest difference"),
+    FConsoleCommandDelegate::CreateLambda([]()
+    {
+        float MaxNoiseError = 0.0f;
+        float MaxInfluenceError = 0.0f;
+        const bool bPassed = FSurvivalTerrainKernels::VerifyVectorKernels(1 << 16, 0.0f, MaxNoiseError, MaxInfluenceError);
+
+        UE_LOG(LogTemp, Log, TEXT("Terrain kernel verification %s - max noise error: %g, max influence error: %g"),
+               bPassed ? TEXT("passed") : TEXT("FAILED"), MaxNoiseError, MaxInfluenceError);
+    }));
+
+namespace SurvivalTerrainKernels
+{
+    // Ken Perlin's reference permutation. Indices are wrapped with & 255 instead of storing the table twice.
+    static const uint8 ReferencePermutation[256] = {
+        151, 160, 137, 91, 90, 15, 131, 13, 201, 95, 96, 53, 194, 233, 7, 225,
+        140, 36, 103, 30, 69, 142, 8, 99, 37, 240, 21, 10, 23, 190, 6, 148,
+        247, 120, 234, 75, 0, 26, 197, 62, 94, 252, 219, 203, 117, 35, 11, 32,
+        57, 177, 33, 88, 237, 149, 56, 87, 174, 20, 125, 136, 171, 168, 68, 175,
+        74, 165, 71, 134, 139, 48, 27, 166, 77, 146, 158, 231, 83, 111, 229, 122,
+        60, 211, 133, 230, 220, 105, 92, 41, 55, 46, 245, 40, 244, 102, 143, 54,
+        65, 25, 63, 161, 1, 216, 80, 73, 209, 76, 132, 187, 208, 89, 18, 169,
+        200, 196, 135, 130, 116, 188, 159, 86, 164, 100, 109, 198, 173, 186, 3, 64,
+        52, 217, 226, 250, 124, 123, 5, 202, 38, 147, 118, 126, 255, 82, 85, 212,
+        207, 206, 59, 227, 47, 16, 58, 17, 182, 189, 28, 42, 223, 183, 170, 213,
+        119, 248, 152, 2, 44, 154, 163, 70, 221, 153, 101, 155, 167, 43, 172, 9,
+        129, 22, 39, 253, 19, 98, 108, 110, 79, 113, 224, 232, 178, 185, 112, 104,
+        218, 246, 97, 228, 251, 34, 242, 193, 238, 210, 144, 12, 191, 179, 162, 241,
+        81, 51, 145, 235, 249, 14, 239, 107, 49, 192, 214, 31, 181, 199, 106, 157,
+        184, 84, 204, 176, 115, 121, 50, 45, 127, 4, 150, 254, 138, 236, 205, 93,
+        222, 114, 67, 29, 24, 72, 243, 141, 128, 195, 78, 66, 215, 61, 156, 180
+    };
+
+    // Gradient directions for Hash & 7: the cube-edge-midpoint set projected onto z = 0.
+    // Expressed as coefficients so the vector path can evaluate them without a switch.
+    static const float GradientX[8] = { 1.0f, 1.0f, 0.0f, -1.0f, -1.0f, -1.0f, 0.0f, 1.0f };
+    static const float GradientY[8] = { 0.0f, 1.0f, 1.0f, 1.0f, 0.0f, -1.0f, -1.0f, -1.0f };
+
+    // Octave k of a fractal noise samples at Scale * Lacunarity^k with weight Gain^k
+    constexpr float FractalLacunarity = 2.0f;
+    constexpr float FractalGain = 0.5f;
+
+    // SplitMix64: integer-only, so seeded tables are identical on every platform
+    FORCEINLINE uint64 SplitMix64(uint64& State)
+    {
+        uint64 Z = (State += 0x9E3779B97F4A7C15ull);
+        Z = (Z ^ (Z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        Z = (Z ^ (Z >> 27)) * 0x94D049BB133111EBull;
+        return Z ^ (Z >> 31);
+    }
+
+    FORCEINLINE float SmoothCurve(float T)
+    {
+        return T * T * T * (T * (T * 6.0f - 15.0f) + 10.0f);
+    }
+
+    // FMath::Lerp's formula, defined here so the contraction pragma above applies to it
+    FORCEINLINE float ScalarLerp(float A, float B, float Alpha)
+    {
+        return A + Alpha * (B - A);
+    }
+
+    FORCEINLINE float Grad2(int32 Hash, float X, float Y)
+    {
+        return GradientX[Hash & 7] * X + GradientY[Hash & 7] * Y;
+    }
+
+    FORCEINLINE VectorRegister4Float VectorSmoothCurve(const VectorRegister4Float& T)
+    {
+        const VectorRegister4Float Inner = VectorAdd(VectorMultiply(T, VectorSubtract(VectorMultiply(T, VectorSetFloat1(6.0f)), VectorSetFloat1(15.0f))), VectorSetFloat1(10.0f));
+        return VectorMultiply(VectorMultiply(VectorMultiply(T, T), T), Inner);
+    }
+
+    FORCEINLINE VectorRegister4Float VectorLerp(const VectorRegister4Float& A, const VectorRegister4Float& B, const VectorRegister4Float& Alpha)
+    {
+        return VectorAdd(A, VectorMultiply(Alpha, VectorSubtract(B, A)));
+    }
+
+    FORCEINLINE VectorRegister4Float VectorGrad2(const float* GX, const float* GY, const VectorRegister4Float& X, const VectorRegister4Float& Y)
+    {
+        return VectorAdd(VectorMultiply(VectorLoadAligned(GX), X), VectorMultiply(VectorLoadAligned(GY), Y));
+    }
+
+    // Noise for exactly four lanes. Table lookups are per lane; everything else stays in registers.
+    void PerlinNoiseBlock(const float* X, const float* Y, float Scale, float Amplitude, const uint8* Permutation, float* Out)
+    {
+        const VectorRegister4Float ScaleVec = VectorSetFloat1(Scale);
+        const VectorRegister4Float One = VectorOneFloat();
+
+        const VectorRegister4Float PX = VectorMultiply(VectorLoad(X), ScaleVec);
+        const VectorRegister4Float PY = VectorMultiply(VectorLoad(Y), ScaleVec);
+        const VectorRegister4Float FloorX = VectorFloor(PX);
+        const VectorRegister4Float FloorY = VectorFloor(PY);
+
+        alignas(16) int32 CellX[4];
+        alignas(16) int32 CellY[4];
+        VectorIntStoreAligned(VectorFloatToInt(FloorX), CellX);
+        VectorIntStoreAligned(VectorFloatToInt(FloorY), CellY);
+
+        alignas(16) float GradAAX[4], GradAAY[4], GradBAX[4], GradBAY[4];
+        alignas(16) float GradABX[4], GradABY[4], GradBBX[4], GradBBY[4];
+
+        for (int32 Lane = 0; Lane < 4; Lane++)
+        {
+            const int32 Xi = CellX[Lane] & 255;
+            const int32 Yi = CellY[Lane] & 255;
+            const int32 AA = Permutation[Xi] + Yi;
+            const int32 BA = Permutation[(Xi + 1) & 255] + Yi;
+
+            const int32 HashAA = Permutation[AA & 255] & 7;
+            const int32 HashBA = Permutation[BA & 255] & 7;
+            const int32 HashAB = Permutation[(AA + 1) & 255] & 7;
+            const int32 HashBB = Permutation[(BA + 1) & 255] & 7;
+
+            GradAAX[Lane] = GradientX[HashAA]; GradAAY[Lane] = GradientY[HashAA];
+            GradBAX[Lane] = GradientX[HashBA]; GradBAY[Lane] = GradientY[HashBA];
+            GradABX[Lane] = GradientX[HashAB]; GradABY[Lane] = GradientY[HashAB];
+            GradBBX[Lane] = GradientX[HashBB]; GradBBY[Lane] = GradientY[HashBB];
+        }
+
+        const VectorRegister4Float FX = VectorSubtract(PX, FloorX);
+        const VectorRegister4Float FY = VectorSubtract(PY, FloorY);
+        const VectorRegister4Float FXm1 = VectorSubtract(FX, One);
+        const VectorRegister4Float FYm1 = VectorSubtract(FY, One);
+
+        const VectorRegister4Float U = VectorSmoothCurve(FX);
+        const VectorRegister4Float V = VectorSmoothCurve(FY);
+
+        const VectorRegister4Float Bottom = VectorLerp(VectorGrad2(GradAAX, GradAAY, FX, FY), VectorGrad2(GradBAX, GradBAY, FXm1, FY), U);
+        const VectorRegister4Float Top = VectorLerp(VectorGrad2(GradABX, GradABY, FX, FYm1), VectorGrad2(GradBBX, GradBBY, FXm1, FYm1), U);
+
+        VectorStore(VectorMultiply(VectorLerp(Bottom, Top, V), VectorSetFloat1(Amplitude)), Out);
+    }
+
+    void ZoneInfluenceBlock(const float* X, const float* Y, float CenterX, float CenterY, float Radius, float* Out)
+    {
+        const VectorRegister4Float DX = VectorSubtract(VectorLoad(X), VectorSetFloat1(CenterX));
+        const VectorRegister4Float DY = VectorSubtract(VectorLoad(Y), VectorSetFloat1(CenterY));
+        const VectorRegister4Float Distance = VectorSqrt(VectorAdd(VectorMultiply(DX, DX), VectorMultiply(DY, DY)));
+
+        const VectorRegister4Float Falloff = VectorSubtract(VectorOneFloat(), VectorDivide(Distance, VectorSetFloat1(Radius)));
+        const VectorRegister4Float T = VectorMin(VectorMax(Falloff, VectorZeroFloat()), VectorOneFloat());
+
+        // T * T * (3 - 2T), the FMath::SmoothStep polynomial
+        const VectorRegister4Float Cubic = VectorSubtract(VectorSetFloat1(3.0f), VectorMultiply(VectorSetFloat1(2.0f), T));
+        VectorStore(VectorMultiply(VectorMultiply(T, T), Cubic), Out);
+    }
+
+    // Runs Block over Count elements four at a time, padding the final partial block
+    template <typename BlockFunc>
+    FORCEINLINE void ForEachBlock(const float* X, const float* Y, float* Out, int32 Count, BlockFunc&& Block)
+    {
+        const int32 FullCount = Count & ~3;
+        for (int32 Index = 0; Index < FullCount; Index += 4)
+        {
+            Block(X + Index, Y + Index, Out + Index);
+        }
+
+        const int32 Remaining = Count - FullCount;
+        if (Remaining > 0)
+        {
+            float PaddedX[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            float PaddedY[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            float PaddedOut[4];
+            FMemory::Memcpy(PaddedX, X + FullCount, Remaining * sizeof(float));
+            FMemory::Memcpy(PaddedY, Y + FullCount, Remaining * sizeof(float));
+
+            Block(PaddedX, PaddedY, PaddedOut);
+            FMemory::Memcpy(Out + FullCount, PaddedOut, Remaining * sizeof(float));
+        }
+    }
+}
+
+FSurvivalNoisePermutation::FSurvivalNoisePermutation(uint32 Seed)
+{
+    using namespace SurvivalTerrainKernels;
+
+    FMemory::Memcpy(Values, ReferencePermutation, sizeof(Values));
+    if (Seed == 0)
+    {
+        return;
+    }
+
+    // Fisher-Yates over the reference table
+    uint64 State = Seed;
+    for (int32 Index = 255; Index > 0; Index--)
+    {
+        const int32 SwapIndex = int32(SplitMix64(State) % uint64(Index + 1));
+        Swap(Values[Index], Values[SwapIndex]);
+    }
+}
+
+const FSurvivalNoisePermutation& FSurvivalNoisePermutation::Reference()
+{
+    static const FSurvivalNoisePermutation ReferenceTable(0);
+    return ReferenceTable;
+}
+
+bool FSurvivalTerrainKernels::UseVectorKernels()
+{
+    return CVarTerrainVectorKernels.GetValueOnAnyThread() != 0;
+}
+
+float FSurvivalTerrainKernels::PerlinNoise2D(float X, float Y, const FSurvivalNoisePermutation& InPermutation)
+{
+    using namespace SurvivalTerrainKernels;
+
+    const uint8* Permutation = InPermutation.Values;
+
+    const float FloorX = FMath::FloorToFloat(X);
+    const float FloorY = FMath::FloorToFloat(Y);
+    const int32 Xi = (int32)FloorX & 255;
+    const int32 Yi = (int32)FloorY & 255;
+
+    const float FX = X - FloorX;
+    const float FY = Y - FloorY;
+    const float FXm1 = FX - 1.0f;
+    const float FYm1 = FY - 1.0f;
+
+    const int32 AA = Permutation[Xi] + Yi;
+    const int32 AB = AA + 1;
+    const int32 BA = Permutation[(Xi + 1) & 255] + Yi;
+    const int32 BB = BA + 1;
+
+    const float U = SmoothCurve(FX);
+    const float V = SmoothCurve(FY);
+
+    // Grad2 keeps the result in (-1, 1) without extra scaling
+    return ScalarLerp(
+        ScalarLerp(Grad2(Permutation[AA & 255], FX, FY), Grad2(Permutation[BA & 255], FXm1, FY), U),
+        ScalarLerp(Grad2(Permutation[AB & 255], FX, FYm1), Grad2(Permutation[BB & 255], FXm1, FYm1), U),
+        V);
+}
+
+void FSurvivalTerrainKernels::PerlinNoise2DBatch(const float* X, const float* Y, float Scale, float Amplitude, float* Out, int32 Count, const FSurvivalNoisePermutation& Permutation)
+{
+    if (UseVectorKernels())
+    {
+        PerlinNoise2DBatch_Vector(X, Y, Scale, Amplitude, Out, Count, Permutation);
+    }
+    else
+    {
+        PerlinNoise2DBatch_Scalar(X, Y, Scale, Amplitude, Out, Count, Permutation);
+    }
+}
+
+void FSurvivalTerrainKernels::PerlinNoise2DBatch_Scalar(const float* X, const float* Y, float Scale, float Amplitude, float* Out, int32 Count, const FSurvivalNoisePermutation& Permutation)
+{
+    for (int32 Index = 0; Index < Count; Index++)
+    {
+        Out[Index] = PerlinNoise2D(X[Index] * Scale, Y[Index] * Scale, Permutation) * Amplitude;
+    }
+}
+
+void FSurvivalTerrainKernels::PerlinNoise2DBatch_Vector(const float* X, const float* Y, float Scale, float Amplitude, float* Out, int32 Count, const FSurvivalNoisePermutation& Permutation)
+{
+    const uint8* PermutationValues = Permutation.Values;
+    SurvivalTerrainKernels::ForEachBlock(X, Y, Out, Count, [Scale, Amplitude, PermutationValues](const float* BlockX, const float* BlockY, float* BlockOut)
+    {
+        SurvivalTerrainKernels::PerlinNoiseBlock(BlockX, BlockY, Scale, Amplitude, PermutationValues, BlockOut);
+    });
+}
+
+float FSurvivalTerrainKernels::ZoneInfluence(float X, float Y, float CenterX, float CenterY, float Radius)
+{
+    if (Radius <= 0.0f)
+    {
+        return 0.0f;
+    }
+
+    const float DX = X - CenterX;
+    const float DY = Y - CenterY;
+    const float Distance = FMath::Sqrt(DX * DX + DY * DY);
+    const float T = FMath::Clamp(1.0f - Distance / Radius, 0.0f, 1.0f);
+
+    return T * T * (3.0f - 2.0f * T);
+}
+
+void FSurvivalTerrainKernels::ZoneInfluenceBatch(const float* X, const float* Y, float CenterX, float CenterY, float Radius, float* OutInfluence, int32 Count)
+{
+    if (UseVectorKernels())
+    {
+        ZoneInfluenceBatch_Vector(X, Y, CenterX, CenterY, Radius, OutInfluence, Count);
+    }
+    else
+    {
+        ZoneInfluenceBatch_Scalar(X, Y, CenterX, CenterY, Radius, OutInfluence, Count);
+    }
+}
+
+void FSurvivalTerrainKernels::ZoneInfluenceBatch_Scalar(const float* X, const float* Y, float CenterX, float CenterY, float Radius, float* OutInfluence, int32 Count)
+{
+    for (int32 Index = 0; Index < Count; Index++)
+    {
+        OutInfluence[Index] = ZoneInfluence(X[Index], Y[Index], CenterX, CenterY, Radius);
+    }
+}
+
+void FSurvivalTerrainKernels::ZoneInfluenceBatch_Vector(const float* X, const float* Y, float CenterX, float CenterY, float Radius, float* OutInfluence, int32 Count)
+{
+    if (Radius <= 0.0f)
+    {
+        FMemory::Memzero(OutInfluence, Count * sizeof(float));
+        return;
+    }
+
+    SurvivalTerrainKernels::ForEachBlock(X, Y, OutInfluence, Count, [CenterX, CenterY, Radius](const float* BlockX, const float* BlockY, float* BlockOut)
+    {
+        SurvivalTerrainKernels::ZoneInfluenceBlock(BlockX, BlockY, CenterX, CenterY, Radius, BlockOut);
+    });
+}
+
+void FSurvivalTerrainKernels::NormalizeWeightsBatch(const float* const* Layers, int32 NumLayers, uint8* const* OutLayers, int32 Count)
+{
+    if (UseVectorKernels())
+    {
+        NormalizeWeightsBatch_Vector(Layers, NumLayers, OutLayers, Count);
+    }
+    else
+    {
+        NormalizeWeightsBatch_Scalar(Layers, NumLayers, OutLayers, Count);
+    }
+}
+
+void FSurvivalTerrainKernels::NormalizeWeightsBatch_Scalar(const float* const* Layers, int32 NumLayers, uint8* const* OutLayers, int32 Count)
+{
+    for (int32 Index = 0; Index < Count; Index++)
+    {
+        float Sum = 0.0f;
+        for (int32 Layer = 0; Layer < NumLayers; Layer++)
+        {
+            Sum += Layers[Layer][Index];
+        }
+
+        const float Scale = Sum > 0.0f ? 255.0f / Sum : 0.0f;
+        float Accumulated = 0.0f;
+        float PreviousRounded = 0.0f;
+        for (int32 Layer = 0; Layer < NumLayers; Layer++)
+        {
+            // Separate statements so the compiler can't fuse them into an FMA the vector path doesn't use
+            const float Scaled = Layers[Layer][Index] * Scale;
+            Accumulated += Scaled;
+            const float Rounded = FMath::FloorToFloat(Accumulated + 0.5f);
+            OutLayers[Layer][Index] = static_cast<uint8>(Rounded - PreviousRounded);
+            PreviousRounded = Rounded;
+        }
+    }
+}
+
+void FSurvivalTerrainKernels::NormalizeWeightsBatch_Vector(const float* const* Layers, int32 NumLayers, uint8* const* OutLayers, int32 Count)
+{
+    // Four texels per register, every layer of them in flight at once
+    auto NormalizeBlock = [NumLayers](const float* const* BlockLayers, int32 Offset, uint8* const* BlockOut, int32 OutOffset, int32 NumTexels)
+    {
+        VectorRegister4Float Sum = VectorZeroFloat();
+        for (int32 Layer = 0; Layer < NumLayers; Layer++)
+        {
+            Sum = VectorAdd(Sum, VectorLoad(BlockLayers[Layer] + Offset));
+        }
+
+        // Lanes with no weight divide by zero; the select throws their result away
+        const VectorRegister4Float HasWeight = VectorCompareGT(Sum, VectorZeroFloat());
+        const VectorRegister4Float Scale = VectorSelect(HasWeight, VectorDivide(VectorSetFloat1(255.0f), Sum), VectorZeroFloat());
+        const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+
+        VectorRegister4Float Accumulated = VectorZeroFloat();
+        VectorRegister4Float PreviousRounded = VectorZeroFloat();
+        for (int32 Layer = 0; Layer < NumLayers; Layer++)
+        {
+            Accumulated = VectorAdd(Accumulated, VectorMultiply(VectorLoad(BlockLayers[Layer] + Offset), Scale));
+            const VectorRegister4Float Rounded = VectorFloor(VectorAdd(Accumulated, Half));
+
+            alignas(16) int32 Quantized[4];
+            VectorIntStoreAligned(VectorFloatToInt(VectorSubtract(Rounded, PreviousRounded)), Quantized);
+            for (int32 Lane = 0; Lane < NumTexels; Lane++)
+            {
+                BlockOut[Layer][OutOffset + Lane] = static_cast<uint8>(Quantized[Lane]);
+            }
+            PreviousRounded = Rounded;
+        }
+    };
+
+    const int32 FullCount = Count & ~3;
+    for (int32 Index = 0; Index < FullCount; Index += 4)
+    {
+        NormalizeBlock(Layers, Index, OutLayers, Index, 4);
+    }
+
+    // Pad the final partial block with zero weights, which normalize to zero
+    const int32 Remaining = Count - FullCount;
+    if (Remaining > 0)
+    {
+        TArray<float, TInlineAllocator<32>> Padded;
+        TArray<const float*, TInlineAllocator<8>> PaddedLayers;
+        Padded.SetNumZeroed(NumLayers * 4);
+        for (int32 Layer = 0; Layer < NumLayers; Layer++)
+        {
+            FMemory::Memcpy(&Padded[Layer * 4], Layers[Layer] + FullCount, Remaining * sizeof(float));
+        }
+        for (int32 Layer = 0; Layer < NumLayers; Layer++)
+        {
+            PaddedLayers.Add(&Padded[Layer * 4]);
+        }
+
+        NormalizeBlock(PaddedLayers.GetData(), 0, OutLayers, FullCount, Remaining);
+    }
+}
+
+bool FSurvivalTerrainKernels::VerifyVectorKernels(int32 NumSamples, float Tolerance, float& OutMaxNoiseError, float& OutMaxInfluenceError)
+{
+    FRandomStream Random(0x5EED);
+
+    TArray<float> X, Y, ScalarOut, VectorOut;
+    X.SetNumUninitialized(NumSamples);
+    Y.SetNumUninitialized(NumSamples);
+    ScalarOut.SetNumUninitialized(NumSamples);
+    VectorOut.SetNumUninitialized(NumSamples);
+
+    // Cover negative coordinates and the lattice wrap at 256 as well as the course extent
+    for (int32 Index = 0; Index < NumSamples; Index++)
+    {
+        X[Index] = Random.FRandRange(-5000.0f, 300000.0f);
+        Y[Index] = Random.FRandRange(-5000.0f, 300000.0f);
+    }
+
+    OutMaxNoiseError = 0.0f;
+    for (const float Scale : { 0.0005f, 0.001f, 0.01f })
+    {
+        PerlinNoise2DBatch_Scalar(X.GetData(), Y.GetData(), Scale, 1.0f, ScalarOut.GetData(), NumSamples);
+        PerlinNoise2DBatch_Vector(X.GetData(), Y.GetData(), Scale, 1.0f, VectorOut.GetData(), NumSamples);
+
+        for (int32 Index = 0; Index < NumSamples; Index++)
+        {
+            OutMaxNoiseError = FMath::Max(OutMaxNoiseError, FMath::Abs(ScalarOut[Index] - VectorOut[Index]));
+        }
+    }
+
+    OutMaxInfluenceError = 0.0f;
+    for (int32 Trial = 0; Trial < 16; Trial++)
+    {
+        const float CenterX = Random.FRandRange(-5000.0f, 300000.0f);
+        const float CenterY = Random.FRandRange(-5000.0f, 300000.0f);
+        const float Radius = Random.FRandRange(100.0f, 150000.0f);
+
+        // Odd counts exercise the padded tail block
+        const int32 Count = NumSamples - (Trial % 4);
+        ZoneInfluenceBatch_Scalar(X.GetData(), Y.GetData(), CenterX, CenterY, Radius, ScalarOut.GetData(), Count);
+        ZoneInfluenceBatch_Vector(X.GetData(), Y.GetData(), CenterX, CenterY, Radius, VectorOut.GetData(), Count);
+
+        for (int32 Index = 0; Index < Count; Index++)
+        {
+            OutMaxInfluenceError = FMath::Max(OutMaxInfluenceError, FMath::Abs(ScalarOut[Index] - VectorOut[Index]));
+        }
+    }
+
+    // Normalized weights are integers and must match exactly, including texels with no weight at all
+    constexpr int32 NumWeightLayers = 4;
+    TArray<float> WeightInputs;
+    TArray<uint8> ScalarWeights, VectorWeights;
+    WeightInputs.SetNumUninitialized(NumWeightLayers * NumSamples);
+    ScalarWeights.SetNumUninitialized(NumWeightLayers * NumSamples);
+    VectorWeights.SetNumUninitialized(NumWeightLayers * NumSamples);
+    for (int32 Index = 0; Index < WeightInputs.Num(); Index++)
+    {
+        WeightInputs[Index] = Random.FRand() < 0.25f ? 0.0f : Random.FRandRange(0.0f, 1.5f);
+    }
+
+    const float* WeightLayers[NumWeightLayers];
+    uint8* ScalarLayers[NumWeightLayers];
+    uint8* VectorLayers[NumWeightLayers];
+    for (int32 Layer = 0; Layer < NumWeightLayers; Layer++)
+    {
+        WeightLayers[Layer] = WeightInputs.GetData() + Layer * NumSamples;
+        ScalarLayers[Layer] = ScalarWeights.GetData() + Layer * NumSamples;
+        VectorLayers[Layer] = VectorWeights.GetData() + Layer * NumSamples;
+    }
+
+    // Odd count exercises the padded tail block
+    NormalizeWeightsBatch_Scalar(WeightLayers, NumWeightLayers, ScalarLayers, NumSamples - 3);
+    NormalizeWeightsBatch_Vector(WeightLayers, NumWeightLayers, VectorLayers, NumSamples - 3);
+
+    bool bWeightsMatch = true;
+    for (int32 Layer = 0; Layer < NumWeightLayers && bWeightsMatch; Layer++)
+    {
+        bWeightsMatch = FMemory::Memcmp(ScalarLayers[Layer], VectorLayers[Layer], NumSamples - 3) == 0;
+    }
+
+    return OutMaxNoiseError <= Tolerance && OutMaxInfluenceError <= Tolerance && bWeightsMatch;
+}
+
+FSurvivalFractalNoise::FSurvivalFractalNoise(uint32 Seed, int32 InNumOctaves)
+    : WeightSum(0.0f)
+{
+    using namespace SurvivalTerrainKernels;
+
+    const int32 NumOctaves = FMath::Clamp(InNumOctaves, 1, MaxOctaves);
+    Octaves.Emplace(Seed);
+
+    // Later octaves get their own tables so they don't repeat the first octave's lattice at a finer scale
+    uint64 State = Seed;
+    for (int32 Octave = 1; Octave < NumOctaves; Octave++)
+    {
+        Octaves.Emplace(uint32(SplitMix64(State)) | 1u);
+    }
+
+    float Weight = 1.0f;
+    for (int32 Octave = 0; Octave < NumOctaves; Octave++)
+    {
+        WeightSum += Weight;
+        Weight *= FractalGain;
+    }
+}
+
+float FSurvivalFractalNoise::GetOctaveAmplitude(int32 Octave, float Amplitude) const
+{
+    // Repeated halving is exact, unlike a library pow, so every platform gets the same octave weights
+    float Weight = 1.0f;
+    for (int32 Step = 0; Step < Octave; Step++)
+    {
+        Weight *= SurvivalTerrainKernels::FractalGain;
+    }
+    return Amplitude * Weight / WeightSum;
+}
+
+float FSurvivalFractalNoise::Sample(float X, float Y, float Scale, float Amplitude) const
+{
+    float Sum = 0.0f;
+    float OctaveScale = Scale;
+    for (int32 Octave = 0; Octave < Octaves.Num(); Octave++)
+    {
+        Sum += FSurvivalTerrainKernels::PerlinNoise2D(X * OctaveScale, Y * OctaveScale, Octaves[Octave]) * GetOctaveAmplitude(Octave, Amplitude);
+        OctaveScale *= SurvivalTerrainKernels::FractalLacunarity;
+    }
+    return Sum;
+}
+
+void FSurvivalFractalNoise::SampleBatch(const float* X, const float* Y, float Scale, float Amplitude, float* Out, int32 Count) const
+{
+    FSurvivalTerrainKernels::PerlinNoise2DBatch(X, Y, Scale, GetOctaveAmplitude(0, Amplitude), Out, Count, Octaves[0]);
+    if (Octaves.Num() == 1)
+    {
+        return;
+    }
+
+    // Accumulate octave by octave in a fixed order so the float sum never depends on scheduling
+    constexpr int32 ChunkSize = 256;
+    float OctaveOut[ChunkSize];
+    for (int32 ChunkStart = 0; ChunkStart < Count; ChunkStart += ChunkSize)
+    {
+        const int32 ChunkCount = FMath::Min(ChunkSize, Count - ChunkStart);
+        float OctaveScale = Scale;
+        for (int32 Octave = 1; Octave < Octaves.Num(); Octave++)
+        {
+            OctaveScale *= SurvivalTerrainKernels::FractalLacunarity;
+            FSurvivalTerrainKernels::PerlinNoise2DBatch(X + ChunkStart, Y + ChunkStart, OctaveScale, GetOctaveAmplitude(Octave, Amplitude), OctaveOut, ChunkCount, Octaves[Octave]);
+            for (int32 Index = 0; Index < ChunkCount; Index++)
+            {
+                Out[ChunkStart + Index] += OctaveOut[Index];
+            }
+        }
+    }
+}
\ No newline at end of file
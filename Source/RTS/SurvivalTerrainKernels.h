@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Lattice permutation of the gradient noise. Seed 0 is Ken Perlin's reference table (the layout every
+// course used before seeding); any other seed shuffles it with an integer-only generator, so the same
+// seed gives the same table on every platform and compiler.
+struct RTS_API FSurvivalNoisePermutation
+{
+    uint8 Values[256];
+
+    explicit FSurvivalNoisePermutation(uint32 Seed = 0);
+
+    static const FSurvivalNoisePermutation& Reference();
+};
+
+// Batched per-texel math for the terrain generators. The vector paths process four texels per
+// VectorRegister4Float; a trailing partial block is padded to four lanes so every texel goes
+// through the same instruction sequence regardless of where it sits in a row. The scalar paths
+// are the reference implementation and the fallback when rts.Terrain.VectorKernels is 0. Both
+// paths perform the same IEEE operations in the same order, compiled without FP contraction, so
+// they agree bit for bit and seeded terrain is identical on every machine whichever path it takes.
+// Four lanes because VectorRegister4Float is the one SIMD width UE provides on every target (SSE and
+// NEON alike); wider AVX or SVE paths would need per-ISA code and dispatch, and parallelism beyond a
+// register comes from the tiled generation spreading rows over worker threads instead.
+struct RTS_API FSurvivalTerrainKernels
+{
+    static constexpr int32 LaneCount = 4;
+
+    // True unless vector kernels are disabled through rts.Terrain.VectorKernels
+    static bool UseVectorKernels();
+
+    // 2D gradient noise in roughly (-1, 1), same formulation as FMath::PerlinNoise2D
+    static float PerlinNoise2D(float X, float Y, const FSurvivalNoisePermutation& Permutation = FSurvivalNoisePermutation::Reference());
+
+    // Out[i] = PerlinNoise2D(X[i] * Scale, Y[i] * Scale) * Amplitude
+    static void PerlinNoise2DBatch(const float* X, const float* Y, float Scale, float Amplitude, float* Out, int32 Count, const FSurvivalNoisePermutation& Permutation = FSurvivalNoisePermutation::Reference());
+    static void PerlinNoise2DBatch_Scalar(const float* X, const float* Y, float Scale, float Amplitude, float* Out, int32 Count, const FSurvivalNoisePermutation& Permutation = FSurvivalNoisePermutation::Reference());
+    static void PerlinNoise2DBatch_Vector(const float* X, const float* Y, float Scale, float Amplitude, float* Out, int32 Count, const FSurvivalNoisePermutation& Permutation = FSurvivalNoisePermutation::Reference());
+
+    // Smooth-stepped falloff from a zone center (1) to its radius (0)
+    static float ZoneInfluence(float X, float Y, float CenterX, float CenterY, float Radius);
+
+    static void ZoneInfluenceBatch(const float* X, const float* Y, float CenterX, float CenterY, float Radius, float* OutInfluence, int32 Count);
+    static void ZoneInfluenceBatch_Scalar(const float* X, const float* Y, float CenterX, float CenterY, float Radius, float* OutInfluence, int32 Count);
+    static void ZoneInfluenceBatch_Vector(const float* X, const float* Y, float CenterX, float CenterY, float Radius, float* OutInfluence, int32 Count);
+
+    // Per texel, scales the weights of NumLayers planes to sum to 255 and quantizes them with error diffusion
+    // across the layers: layer L gets round(C[L]) - round(C[L - 1]) of the running sum C, so every texel's
+    // bytes sum to exactly 255 and no layer is off by a whole step. Texels whose weights are all 0 stay 0.
+    // Both paths perform the same float operations in the same order and agree bit for bit.
+    static void NormalizeWeightsBatch(const float* const* Layers, int32 NumLayers, uint8* const* OutLayers, int32 Count);
+    static void NormalizeWeightsBatch_Scalar(const float* const* Layers, int32 NumLayers, uint8* const* OutLayers, int32 Count);
+    static void NormalizeWeightsBatch_Vector(const float* const* Layers, int32 NumLayers, uint8* const* OutLayers, int32 Count);
+
+    // Runs both paths over NumSamples random inputs. Returns false if any result differs by more than Tolerance
+    // (0 for the bit-exactness check of rts.Terrain.VerifyKernels), or if normalized weights differ at all.
+    static bool VerifyVectorKernels(int32 NumSamples, float Tolerance, float& OutMaxNoiseError, float& OutMaxInfluenceError);
+};
+
+// Seeded multi-octave (fBm) gradient noise. Octave 0 uses the seed's own permutation, so a single octave
+// equals PerlinNoise2D with FSurvivalNoisePermutation(Seed); each further octave doubles the frequency,
+// halves the amplitude and gets a permutation derived from the seed. Octaves are summed in order and
+// normalized back to (-1, 1). Build one per tile or batch; construction shuffles a table per octave.
+class RTS_API FSurvivalFractalNoise
+{
+public:
+    static constexpr int32 MaxOctaves = 8;
+
+    explicit FSurvivalFractalNoise(uint32 Seed, int32 InNumOctaves = 1);
+
+    int32 GetNumOctaves() const { return Octaves.Num(); }
+
+    // Noise at (X * Scale, Y * Scale) times Amplitude; matches SampleBatch exactly
+    float Sample(float X, float Y, float Scale, float Amplitude) const;
+
+    // Out[i] = Sample(X[i], Y[i], Scale, Amplitude), through the vector kernels when they are enabled
+    void SampleBatch(const float* X, const float* Y, float Scale, float Amplitude, float* Out, int32 Count) const;
+
+private:
+    float GetOctaveAmplitude(int32 Octave, float Amplitude) const;
+
+    TArray<FSurvivalNoisePermutation, TInlineAllocator<MaxOctaves>> Octaves;
+
+    // Sum of the octave weights, so the total stays within (-1, 1)
+    float WeightSum;
+};
\ No newline at end of file
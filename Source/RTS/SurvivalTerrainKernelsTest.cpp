@@ -0,0 +1,24 @@
+#include "SurvivalTerrainKernels.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSurvivalTerrainKernelsBitExactTest, "RTS.Terrain.Kernels.BitExact",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSurvivalTerrainKernelsBitExactTest::RunTest(const FString& Parameters)
+{
+    // Not a multiple of LaneCount, so the padded trailing block is covered too
+    const int32 NumSamples = (1 << 16) + FSurvivalTerrainKernels::LaneCount - 1;
+
+    float MaxNoiseError = 0.0f;
+    float MaxInfluenceError = 0.0f;
+    const bool bPassed = FSurvivalTerrainKernels::VerifyVectorKernels(NumSamples, 0.0f, MaxNoiseError, MaxInfluenceError);
+
+    TestEqual(TEXT("Max noise error"), MaxNoiseError, 0.0f);
+    TestEqual(TEXT("Max influence error"), MaxInfluenceError, 0.0f);
+    TestTrue(TEXT("Vector kernels match the scalar reference bit for bit"), bPassed);
+    return true;
+}
+
+#endif
\ No newline at end of file
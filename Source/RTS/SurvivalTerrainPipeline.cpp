@@ -0,0 +1,1125 @@
+#include "SurvivalTerrainPipeline.h"
+#include "SurvivalBiomeManager.h"
+#include "SurvivalTerrainKernels.h"
+#include "Hash/xxhash.h"
+#include "Tasks/Task.h"
+
+// Elevation is rebuilt on clients from the replicated seed; keep its float math unfused like the kernels'
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(_MSC_VER)
+#pragma float_control(precise, on)
+#pragma fp_contract(off)
+#endif
+
+namespace SurvivalTerrainPipelineConstants
+{
+    // Bump whenever a stage produces different output for the same inputs, so stale cache entries can't match
+    constexpr uint32 PipelineVersion = 2;
+
+    // Zone edits remembered for patching; cache entries older than this are regenerated in full
+    constexpr int32 MaxTrackedZoneChanges = 32;
+
+    template<typename ValueType>
+    void AppendHash(FXxHash64Builder& Builder, const ValueType& Value)
+    {
+        static_assert(std::is_arithmetic_v<ValueType> || std::is_enum_v<ValueType>, "Hash individual fields, never padded structs");
+        Builder.Update(&Value, sizeof(ValueType));
+    }
+}
+
+FSurvivalTerrainJob::FSurvivalTerrainJob()
+    : bCancelled(false)
+    , CompletedTexels(0)
+    , LastReportedStep(0)
+    , TotalTexels(0)
+{
+}
+
+float FSurvivalTerrainJob::GetProgress() const
+{
+    return TotalTexels > 0 ? FMath::Min(float(double(CompletedTexels) / double(TotalTexels)), 1.0f) : 0.0f;
+}
+
+void FSurvivalTerrainJob::Begin(int64 InTotalTexels)
+{
+    TotalTexels = InTotalTexels;
+    CompletedTexels = 0;
+    LastReportedStep = 0;
+}
+
+void FSurvivalTerrainJob::AddCompletedTexels(int64 NumTexels)
+{
+    CompletedTexels += NumTexels;
+    if (!OnProgress)
+    {
+        return;
+    }
+
+    // Only the worker that advances the step reports it, so listeners see each step once and in order
+    const int32 Step = FMath::FloorToInt(GetProgress() / ProgressStep);
+    int32 ReportedStep = LastReportedStep;
+    while (Step > ReportedStep)
+    {
+        if (LastReportedStep.compare_exchange_weak(ReportedStep, Step))
+        {
+            OnProgress(Step * ProgressStep);
+            break;
+        }
+    }
+}
+
+FSurvivalTerrainPipeline::FSurvivalTerrainPipeline()
+    : ZonesHash(0)
+    , ZoneRevision(0)
+    , FirstTrackedRevision(0)
+{
+}
+
+void FSurvivalTerrainPipeline::SetBiomeZones(const TArray<FBiomeZone>& Zones, const FBox2D& DirtyWorldBounds)
+{
+    using namespace SurvivalTerrainPipelineConstants;
+
+    ZoneIndex.Build(Zones);
+
+    // Only the fields that shape the terrain; speed and calorie multipliers leave every stage valid
+    FXxHash64Builder Builder;
+    Builder.Update(ZoneIndex.GetCentersX().GetData(), ZoneIndex.GetCentersX().Num() * sizeof(double));
+    Builder.Update(ZoneIndex.GetCentersY().GetData(), ZoneIndex.GetCentersY().Num() * sizeof(double));
+    Builder.Update(ZoneIndex.GetRadii().GetData(), ZoneIndex.GetRadii().Num() * sizeof(float));
+    Builder.Update(ZoneIndex.GetBiomeTypes().GetData(), ZoneIndex.GetBiomeTypes().Num() * sizeof(EBiomeType));
+    ZonesHash = Builder.Finalize().Hash;
+
+    ZoneChanges.Add(DirtyWorldBounds);
+    ZoneRevision++;
+
+    if (ZoneChanges.Num() > MaxTrackedZoneChanges)
+    {
+        ZoneChanges.RemoveAt(0);
+        FirstTrackedRevision++;
+    }
+}
+
+void FSurvivalTerrainPipeline::ResetCache()
+{
+    InfluenceCache.Entries.Reset();
+    ElevationCache.Entries.Reset();
+    SlopeCache.Entries.Reset();
+    LayerWeightsCache.Entries.Reset();
+    BlendedWeightsCache.Entries.Reset();
+}
+
+FSurvivalTerrainPipeline::FStageKey FSurvivalTerrainPipeline::ChainKey(const FStageKey& Upstream, TFunctionRef<void(FXxHash64Builder&)> AppendSettings)
+{
+    using namespace SurvivalTerrainPipelineConstants;
+
+    FXxHash64Builder InputBuilder;
+    AppendHash(InputBuilder, Upstream.InputHash);
+    AppendSettings(InputBuilder);
+
+    FXxHash64Builder SettingsBuilder;
+    AppendHash(SettingsBuilder, Upstream.SettingsHash);
+    AppendSettings(SettingsBuilder);
+
+    return { InputBuilder.Finalize().Hash, SettingsBuilder.Finalize().Hash };
+}
+
+FSurvivalTerrainPipeline::FStageKeys FSurvivalTerrainPipeline::ComputeStageKeys(const FSurvivalTerrainRequest& Request) const
+{
+    using namespace SurvivalTerrainPipelineConstants;
+
+    FStageKeys Keys;
+
+    // The zone layout is the root input; the settings hash chain leaves it out
+    Keys.Influence = ChainKey({ ZonesHash, 0 }, [&Request](FXxHash64Builder& Builder)
+    {
+        AppendHash(Builder, PipelineVersion);
+        // The paths agree bit for bit, but a cache entry never outlives a switch between them
+        AppendHash(Builder, FSurvivalTerrainKernels::UseVectorKernels());
+        AppendHash(Builder, Request.Grid.Resolution);
+        AppendHash(Builder, Request.Grid.WorldExtent.X);
+        AppendHash(Builder, Request.Grid.WorldExtent.Y);
+    });
+
+    Keys.Elevation = ChainKey(Keys.Influence, [&Request](FXxHash64Builder& Builder)
+    {
+        AppendHash(Builder, Request.Elevation.NoiseScale);
+        AppendHash(Builder, Request.Elevation.NoiseAmplitude);
+        AppendHash(Builder, Request.Elevation.MaxElevation);
+        AppendHash(Builder, Request.Elevation.Seed);
+        AppendHash(Builder, Request.Elevation.NoiseOctaves);
+    });
+
+    Keys.Slope = ChainKey(Keys.Elevation, [](FXxHash64Builder&) {});
+
+    // Altitude blending makes the weights depend on the terrain, so its whole elevation chain goes into their key
+    Keys.LayerWeights = ChainKey(Request.Layers.bUseAltitudeBlending ? Keys.Slope : Keys.Influence, [&Request](FXxHash64Builder& Builder)
+    {
+        AppendHash(Builder, Request.Layers.LayerBiomes.Num());
+        for (EBiomeType LayerBiome : Request.Layers.LayerBiomes)
+        {
+            AppendHash(Builder, LayerBiome);
+        }
+        AppendHash(Builder, Request.Layers.bUseAltitudeBlending);
+        AppendHash(Builder, Request.Layers.bNormalizeWeights);
+    });
+
+    Keys.BorderBlend = ChainKey(Keys.LayerWeights, [&Request](FXxHash64Builder& Builder)
+    {
+        AppendHash(Builder, Request.Layers.BlendSmoothness);
+        AppendHash(Builder, GetBlendKernelSize(Request));
+    });
+
+    return Keys;
+}
+
+uint64 FSurvivalTerrainPipeline::GetStageHash(const FSurvivalTerrainRequest& Request, ESurvivalTerrainStage Stage) const
+{
+    const FStageKeys Keys = ComputeStageKeys(Request);
+
+    switch (Stage)
+    {
+        case ESurvivalTerrainStage::Influence:
+            return Keys.Influence.InputHash;
+        case ESurvivalTerrainStage::Elevation:
+            return Keys.Elevation.InputHash;
+        case ESurvivalTerrainStage::Slope:
+            return Keys.Slope.InputHash;
+        case ESurvivalTerrainStage::LayerWeights:
+            return Keys.LayerWeights.InputHash;
+        case ESurvivalTerrainStage::BorderBlend:
+        default:
+            return Keys.BorderBlend.InputHash;
+    }
+}
+
+FSurvivalTerrainResult FSurvivalTerrainPipeline::Run(const FSurvivalTerrainRequest& Request)
+{
+    FSurvivalTerrainResult Result;
+    const FSurvivalTerrainGrid& Grid = Request.Grid;
+
+    if (Grid.Resolution < 2)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Terrain pipeline: invalid grid resolution %d"), Grid.Resolution);
+        return Result;
+    }
+
+    // Altitude blending reads the elevation and slope under every texel
+    const bool bLayersNeedTerrain = Request.bGenerateLayerWeights && Request.Layers.bUseAltitudeBlending;
+    const bool bRunSlope = Request.bGenerateSlope || bLayersNeedTerrain;
+    const bool bRunElevation = Request.bGenerateElevation || bRunSlope;
+
+    FSurvivalTerrainJob* Job = Request.Job.Get();
+    if (Job)
+    {
+        const int32 NumStages = 1 + (bRunElevation ? 1 : 0) + (bRunSlope ? 1 : 0) + (Request.bGenerateLayerWeights ? 2 : 0);
+        Job->Begin(int64(NumStages) * Grid.NumTexels());
+    }
+
+    const FStageKeys Keys = ComputeStageKeys(Request);
+    const FStageKey& InfluenceKey = Keys.Influence;
+    const FStageKey& ElevationKey = Keys.Elevation;
+    const FStageKey& SlopeKey = Keys.Slope;
+    const FStageKey& LayerWeightsKey = Keys.LayerWeights;
+    const FStageKey& BlendedWeightsKey = Keys.BorderBlend;
+
+    // Influence first; elevation -> slope and layer weights -> border blend then run side by side, except that
+    // altitude blended layer weights wait for the slope
+    TArray<UE::Tasks::FTask> Tasks;
+
+    UE::Tasks::FTask InfluenceTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, &Request, &Grid, &Result, &InfluenceKey, Job]
+    {
+        const double StageStartTime = FPlatformTime::Seconds();
+        Result.Influence = RunStage<FSurvivalInfluenceField>(InfluenceCache, InfluenceKey, Grid, 0, Job, Result.StagePatched[int32(ESurvivalTerrainStage::Influence)],
+            [&Grid](FSurvivalInfluenceField& Field)
+            {
+                Field.Grid = Grid;
+                Field.SummedInfluence.SetNumUninitialized(NumBiomeTypes * Grid.NumTexels());
+                Field.PeakInfluence.SetNumUninitialized(NumBiomeTypes * Grid.NumTexels());
+                Field.AlpineCoreInfluence.SetNumUninitialized(Grid.NumTexels());
+            },
+            [this, &Request, &Grid](const FSurvivalTerrainTile& Region, FSurvivalInfluenceField& Field)
+            {
+                ForEachTile(Request, Region, [this, &Request, &Grid, &Field](const FSurvivalTerrainTile& Tile)
+                {
+                    TArray<int32> TileZones;
+                    if (Request.bUseTiledGeneration)
+                    {
+                        // Only zones that can reach this tile are evaluated; the rest would contribute zero influence
+                        const FBox2D TileBounds(FVector2D(Grid.TexelToWorldX(Tile.MinX), Grid.TexelToWorldY(Tile.MinY)),
+                                                FVector2D(Grid.TexelToWorldX(Tile.MaxX - 1), Grid.TexelToWorldY(Tile.MaxY - 1)));
+                        ZoneIndex.GatherZonesOverlappingRect(TileBounds, TileZones);
+                    }
+                    else
+                    {
+                        // Reference path: every zone evaluated for every texel
+                        TileZones.Reserve(ZoneIndex.Num());
+                        for (int32 Zone = 0; Zone < ZoneIndex.Num(); Zone++)
+                        {
+                            TileZones.Add(Zone);
+                        }
+                    }
+
+                    GenerateInfluenceTile(Tile, TileZones, Field);
+                });
+            });
+        Result.StageSeconds[int32(ESurvivalTerrainStage::Influence)] = FPlatformTime::Seconds() - StageStartTime;
+    });
+    Tasks.Add(InfluenceTask);
+
+    UE::Tasks::FTask SlopeTask;
+    if (bRunElevation)
+    {
+        UE::Tasks::FTask ElevationTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, &Request, &Grid, &Result, &ElevationKey, Job]
+        {
+            if (!Result.Influence.IsValid())
+            {
+                return; // Cancelled
+            }
+
+            const FSurvivalInfluenceField& Influence = *Result.Influence;
+            const double StageStartTime = FPlatformTime::Seconds();
+            Result.Elevation = RunStage<FSurvivalElevationField>(ElevationCache, ElevationKey, Grid, 0, Job, Result.StagePatched[int32(ESurvivalTerrainStage::Elevation)],
+                [&Request, &Grid](FSurvivalElevationField& Field)
+                {
+                    Field.Grid = Grid;
+                    Field.MaxElevation = Request.Elevation.MaxElevation;
+                    Field.Elevation.SetNumUninitialized(Grid.NumTexels());
+                },
+                [this, &Request, &Influence](const FSurvivalTerrainTile& Region, FSurvivalElevationField& Field)
+                {
+                    ForEachTile(Request, Region, [this, &Request, &Influence, &Field](const FSurvivalTerrainTile& Tile)
+                    {
+                        GenerateElevationTile(Tile, Influence, Request.Elevation, Field);
+                    });
+                });
+            Result.StageSeconds[int32(ESurvivalTerrainStage::Elevation)] = FPlatformTime::Seconds() - StageStartTime;
+        }, UE::Tasks::Prerequisites(InfluenceTask));
+        Tasks.Add(ElevationTask);
+
+        if (bRunSlope)
+        {
+            // Central differences read one texel beyond the dirty elevation
+            SlopeTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, &Request, &Grid, &Result, &SlopeKey, Job]
+            {
+                if (!Result.Elevation.IsValid())
+                {
+                    return;
+                }
+
+                const FSurvivalElevationField& Elevation = *Result.Elevation;
+                const double StageStartTime = FPlatformTime::Seconds();
+                Result.Slope = RunStage<FSurvivalSlopeField>(SlopeCache, SlopeKey, Grid, 1, Job, Result.StagePatched[int32(ESurvivalTerrainStage::Slope)],
+                    [&Grid](FSurvivalSlopeField& Field)
+                    {
+                        Field.Grid = Grid;
+                        Field.SlopeDegrees.SetNumUninitialized(Grid.NumTexels());
+                    },
+                    [this, &Request, &Elevation](const FSurvivalTerrainTile& Region, FSurvivalSlopeField& Field)
+                    {
+                        ForEachTile(Request, Region, [this, &Elevation, &Field](const FSurvivalTerrainTile& Tile)
+                        {
+                            GenerateSlopeTile(Tile, Elevation, Field);
+                        });
+                    });
+                Result.StageSeconds[int32(ESurvivalTerrainStage::Slope)] = FPlatformTime::Seconds() - StageStartTime;
+            }, UE::Tasks::Prerequisites(ElevationTask));
+            Tasks.Add(SlopeTask);
+        }
+    }
+
+    if (Request.bGenerateLayerWeights)
+    {
+        TArray<UE::Tasks::FTask> LayerWeightsPrerequisites = { InfluenceTask };
+        if (bLayersNeedTerrain)
+        {
+            LayerWeightsPrerequisites.Add(SlopeTask);
+        }
+
+        // Slope, and so the weights that read it, can change one texel beyond the dirty elevation
+        const int32 LayerWeightsGrowTexels = bLayersNeedTerrain ? 1 : 0;
+
+        UE::Tasks::FTask LayerWeightsTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, &Request, &Grid, &Result, &LayerWeightsKey, LayerWeightsGrowTexels, bLayersNeedTerrain, Job]
+        {
+            if (!Result.Influence.IsValid() || (bLayersNeedTerrain && !Result.Slope.IsValid()))
+            {
+                return;
+            }
+
+            const FSurvivalInfluenceField& Influence = *Result.Influence;
+            const FSurvivalElevationField* Elevation = bLayersNeedTerrain ? Result.Elevation.Get() : nullptr;
+            const FSurvivalSlopeField* Slope = bLayersNeedTerrain ? Result.Slope.Get() : nullptr;
+            const double StageStartTime = FPlatformTime::Seconds();
+            Result.RawLayerWeights = RunStage<FSurvivalLayerWeights>(LayerWeightsCache, LayerWeightsKey, Grid, LayerWeightsGrowTexels, Job, Result.StagePatched[int32(ESurvivalTerrainStage::LayerWeights)],
+                [&Request, &Grid](FSurvivalLayerWeights& Weights)
+                {
+                    Weights.Grid = Grid;
+                    Weights.LayerBiomes = Request.Layers.LayerBiomes;
+                    Weights.Layers.SetNum(Request.Layers.LayerBiomes.Num());
+                    for (TArray<uint8>& Layer : Weights.Layers)
+                    {
+                        Layer.SetNumUninitialized(Grid.NumTexels());
+                    }
+                },
+                [this, &Request, &Influence, Elevation, Slope](const FSurvivalTerrainTile& Region, FSurvivalLayerWeights& Weights)
+                {
+                    ForEachTile(Request, Region, [this, &Request, &Influence, Elevation, Slope, &Weights](const FSurvivalTerrainTile& Tile)
+                    {
+                        GenerateLayerWeightsTile(Tile, Influence, Elevation, Slope, Request.Layers, Weights);
+                    });
+                });
+            Result.StageSeconds[int32(ESurvivalTerrainStage::LayerWeights)] = FPlatformTime::Seconds() - StageStartTime;
+        }, LayerWeightsPrerequisites);
+        Tasks.Add(LayerWeightsTask);
+
+        // Every texel whose smoothing window overlaps changed weights has to be re-blended, and the raw weights
+        // already reach LayerWeightsGrowTexels beyond the dirty region
+        const int32 BlendGrowTexels = GetBlendKernelSize(Request) + LayerWeightsGrowTexels;
+
+        Tasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, &Request, &Grid, &Result, &BlendedWeightsKey, BlendGrowTexels, Job]
+        {
+            if (!Result.RawLayerWeights.IsValid())
+            {
+                return;
+            }
+
+            const FSurvivalLayerWeights& RawWeights = *Result.RawLayerWeights;
+            const double StageStartTime = FPlatformTime::Seconds();
+            Result.BlendedLayerWeights = RunStage<FSurvivalLayerWeights>(BlendedWeightsCache, BlendedWeightsKey, Grid, BlendGrowTexels, Job, Result.StagePatched[int32(ESurvivalTerrainStage::BorderBlend)],
+                [&RawWeights](FSurvivalLayerWeights& Weights)
+                {
+                    Weights = RawWeights;
+                    Weights.PackedTexels.SetNumZeroed(RawWeights.Grid.NumTexels());
+                },
+                [this, &Request, &RawWeights](const FSurvivalTerrainTile& Region, FSurvivalLayerWeights& Weights)
+                {
+                    BlendLayerWeights(Request, Region, RawWeights, Weights);
+                });
+            Result.StageSeconds[int32(ESurvivalTerrainStage::BorderBlend)] = FPlatformTime::Seconds() - StageStartTime;
+        }, UE::Tasks::Prerequisites(LayerWeightsTask)));
+    }
+
+    UE::Tasks::Wait(Tasks);
+
+    // Stages that finished before the cancellation are cached, but a caller never sees a partial result
+    if (Job && Job->IsCancelled())
+    {
+        return FSurvivalTerrainResult();
+    }
+
+    return Result;
+}
+
+void FSurvivalTerrainPipeline::GenerateElevationTiles(const FSurvivalTerrainRequest& Request, const TArray<FSurvivalTerrainTile>& Tiles,
+                                                      TFunctionRef<void(const FSurvivalTerrainTile&, const FSurvivalElevationField&)> OnTileGenerated) const
+{
+    if (Request.Grid.Resolution < 2)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Terrain pipeline: invalid grid resolution %d"), Request.Grid.Resolution);
+        return;
+    }
+
+    FSurvivalTerrainTiling::ParallelForEachTile(Tiles, [this, &Request, &OnTileGenerated](const FSurvivalTerrainTile& Tile)
+    {
+        const FSurvivalTerrainGrid TileGrid = Request.Grid.GetWindowed(Tile);
+
+        FSurvivalInfluenceField Influence;
+        Influence.Grid = TileGrid;
+        Influence.SummedInfluence.SetNumUninitialized(NumBiomeTypes * TileGrid.NumTexels());
+        Influence.PeakInfluence.SetNumUninitialized(NumBiomeTypes * TileGrid.NumTexels());
+        Influence.AlpineCoreInfluence.SetNumUninitialized(TileGrid.NumTexels());
+
+        FSurvivalElevationField Elevation;
+        Elevation.Grid = TileGrid;
+        Elevation.MaxElevation = Request.Elevation.MaxElevation;
+        Elevation.Elevation.SetNumUninitialized(TileGrid.NumTexels());
+
+        // Streamed tiles are far larger than a cache-sized tile, so zones are still culled per sub-tile
+        TArray<FSurvivalTerrainTile> SubTiles;
+        FSurvivalTerrainTiling::BuildTiles(Tile, Request.TileSize, SubTiles);
+
+        TArray<int32> SubTileZones;
+        for (const FSurvivalTerrainTile& SubTile : SubTiles)
+        {
+            const FBox2D SubTileBounds(FVector2D(TileGrid.TexelToWorldX(SubTile.MinX), TileGrid.TexelToWorldY(SubTile.MinY)),
+                                       FVector2D(TileGrid.TexelToWorldX(SubTile.MaxX - 1), TileGrid.TexelToWorldY(SubTile.MaxY - 1)));
+            SubTileZones.Reset();
+            ZoneIndex.GatherZonesOverlappingRect(SubTileBounds, SubTileZones);
+
+            GenerateInfluenceTile(SubTile, SubTileZones, Influence);
+            GenerateElevationTile(SubTile, Influence, Request.Elevation, Elevation);
+        }
+
+        OnTileGenerated(Tile, Elevation);
+    });
+}
+
+template<typename OutputType>
+TSharedPtr<const OutputType> FSurvivalTerrainPipeline::RunStage(TSurvivalTerrainStageCache<OutputType>& Cache, const FStageKey& Key, const FSurvivalTerrainGrid& Grid, int32 GrowTexels, FSurvivalTerrainJob* Job, bool& bOutPatched,
+                                                                TFunctionRef<void(OutputType&)> Allocate, TFunctionRef<void(const FSurvivalTerrainTile&, OutputType&)> Generate)
+{
+    if (TSharedPtr<const OutputType> Cached = Cache.Find(Key.InputHash, bOutPatched))
+    {
+        if (Job)
+        {
+            Job->AddCompletedTexels(Grid.NumTexels());
+        }
+        return Cached;
+    }
+
+    TSharedRef<OutputType> Output = MakeShared<OutputType>();
+    FSurvivalTerrainTile Region(0, 0, Grid.Resolution, Grid.Resolution);
+
+    // Start from the last output with the same settings and only regenerate what the zone edits touched
+    const typename TSurvivalTerrainStageCache<OutputType>::FEntry* Patchable = Cache.FindPatchable(Key.SettingsHash);
+    FSurvivalTerrainTile DirtyRegion;
+    if (Patchable && GetDirtyRegionSince(Patchable->ZoneRevision, Grid, GrowTexels, DirtyRegion))
+    {
+        *Output = *Patchable->Output;
+        Region = DirtyRegion;
+        bOutPatched = true;
+    }
+    else
+    {
+        Allocate(*Output);
+    }
+
+    if (Job)
+    {
+        // Texels outside a patched region count as done up front
+        const int64 RegionTexels = Region.IsEmpty() ? 0 : int64(Region.GetWidth()) * Region.GetHeight();
+        Job->AddCompletedTexels(Grid.NumTexels() - RegionTexels);
+    }
+
+    if (!Region.IsEmpty())
+    {
+        Generate(Region, *Output);
+    }
+
+    if (Job && Job->IsCancelled())
+    {
+        return nullptr;
+    }
+
+    Cache.Add(Key.InputHash, Key.SettingsHash, ZoneRevision, bOutPatched, Output);
+    return Output;
+}
+
+bool FSurvivalTerrainPipeline::GetDirtyRegionSince(int32 Revision, const FSurvivalTerrainGrid& Grid, int32 GrowTexels, FSurvivalTerrainTile& OutRegion) const
+{
+    if (Revision < FirstTrackedRevision || Revision > ZoneRevision)
+    {
+        return false;
+    }
+
+    FBox2D DirtyWorldBounds(ForceInit);
+    for (int32 Change = Revision - FirstTrackedRevision; Change < ZoneChanges.Num(); Change++)
+    {
+        if (!ZoneChanges[Change].bIsValid)
+        {
+            return false; // Full invalidation
+        }
+        DirtyWorldBounds += ZoneChanges[Change];
+    }
+
+    if (!DirtyWorldBounds.bIsValid)
+    {
+        OutRegion = FSurvivalTerrainTile();
+        return true;
+    }
+
+    const FSurvivalTerrainTile Region = FSurvivalTerrainTiling::WorldBoundsToTexelRegion(DirtyWorldBounds, Grid.WorldExtent, Grid.Resolution, Grid.Resolution);
+    if (Region.IsEmpty())
+    {
+        OutRegion = Region;
+        return true;
+    }
+
+    OutRegion = FSurvivalTerrainTile(
+        FMath::Max(Region.MinX - GrowTexels, 0),
+        FMath::Max(Region.MinY - GrowTexels, 0),
+        FMath::Min(Region.MaxX + GrowTexels, Grid.Resolution),
+        FMath::Min(Region.MaxY + GrowTexels, Grid.Resolution));
+    return true;
+}
+
+void FSurvivalTerrainPipeline::ForEachTile(const FSurvivalTerrainRequest& Request, const FSurvivalTerrainTile& Region, TFunctionRef<void(const FSurvivalTerrainTile&)> Body) const
+{
+    FSurvivalTerrainJob* Job = Request.Job.Get();
+    auto RunTile = [Job, &Body](const FSurvivalTerrainTile& Tile)
+    {
+        if (Job && Job->IsCancelled())
+        {
+            return;
+        }
+
+        Body(Tile);
+
+        if (Job)
+        {
+            Job->AddCompletedTexels(int64(Tile.GetWidth()) * Tile.GetHeight());
+        }
+    };
+
+    if (!Request.bUseTiledGeneration)
+    {
+        RunTile(Region);
+        return;
+    }
+
+    TArray<FSurvivalTerrainTile> Tiles;
+    FSurvivalTerrainTiling::BuildTiles(Region, Request.TileSize, Tiles);
+    FSurvivalTerrainTiling::ParallelForEachTile(Tiles, RunTile);
+}
+
+void FSurvivalTerrainPipeline::GenerateInfluenceTile(const FSurvivalTerrainTile& Tile, const TArray<int32>& ZoneIndices, FSurvivalInfluenceField& Field) const
+{
+    const FSurvivalTerrainGrid& Grid = Field.Grid;
+    const int32 NumTexels = Grid.NumTexels();
+    const int32 SpanWidth = Tile.GetWidth();
+
+    // Row scratch buffers for the batch kernels; X coordinates are shared by every row of the tile
+    TArray<float> WorldX, WorldY, Influence;
+    WorldX.SetNumUninitialized(SpanWidth);
+    WorldY.SetNumUninitialized(SpanWidth);
+    Influence.SetNumUninitialized(SpanWidth);
+
+    for (int32 X = Tile.MinX; X < Tile.MaxX; X++)
+    {
+        WorldX[X - Tile.MinX] = Grid.TexelToWorldX(X);
+    }
+
+    for (int32 Y = Tile.MinY; Y < Tile.MaxY; Y++)
+    {
+        const float RowWorldY = Grid.TexelToWorldY(Y);
+        const int32 RowOffset = Grid.TexelIndex(Tile.MinX, Y);
+        for (int32 Index = 0; Index < SpanWidth; Index++)
+        {
+            WorldY[Index] = RowWorldY;
+        }
+
+        // Patched regions start from a copy of the previous field, so every plane is cleared before accumulating
+        for (int32 BiomeIndex = 0; BiomeIndex < NumBiomeTypes; BiomeIndex++)
+        {
+            FMemory::Memzero(Field.SummedInfluence.GetData() + BiomeIndex * NumTexels + RowOffset, SpanWidth * sizeof(float));
+            FMemory::Memzero(Field.PeakInfluence.GetData() + BiomeIndex * NumTexels + RowOffset, SpanWidth * sizeof(float));
+        }
+        FMemory::Memzero(Field.AlpineCoreInfluence.GetData() + RowOffset, SpanWidth * sizeof(float));
+
+        for (int32 Zone : ZoneIndices)
+        {
+            const float ZoneCenterX = ZoneIndex.GetCentersX()[Zone];
+            const float ZoneCenterY = ZoneIndex.GetCentersY()[Zone];
+            const float ZoneRadius = ZoneIndex.GetRadii()[Zone];
+            if (FMath::Abs(RowWorldY - ZoneCenterY) >= ZoneRadius)
+            {
+                continue; // Zone doesn't reach this row
+            }
+
+            FSurvivalTerrainKernels::ZoneInfluenceBatch(WorldX.GetData(), WorldY.GetData(), ZoneCenterX, ZoneCenterY, ZoneRadius, Influence.GetData(), SpanWidth);
+
+            const EBiomeType BiomeType = ZoneIndex.GetBiomeType(Zone);
+            float* SummedRow = Field.SummedInfluence.GetData() + int32(BiomeType) * NumTexels + RowOffset;
+            float* PeakRow = Field.PeakInfluence.GetData() + int32(BiomeType) * NumTexels + RowOffset;
+            for (int32 Index = 0; Index < SpanWidth; Index++)
+            {
+                if (Influence[Index] > 0.0f)
+                {
+                    SummedRow[Index] += Influence[Index];
+                    PeakRow[Index] = FMath::Max(PeakRow[Index], Influence[Index]);
+                }
+            }
+
+            if (BiomeType == EBiomeType::Alpine)
+            {
+                float* CoreRow = Field.AlpineCoreInfluence.GetData() + RowOffset;
+                for (int32 Index = 0; Index < SpanWidth; Index++)
+                {
+                    if (Influence[Index] > 0.0f)
+                    {
+                        const float DistanceFromCenter = FMath::Sqrt(FMath::Square(WorldX[Index] - ZoneCenterX) + FMath::Square(RowWorldY - ZoneCenterY));
+                        CoreRow[Index] += Influence[Index] * CalculateCoreInfluence(DistanceFromCenter, ZoneRadius);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void FSurvivalTerrainPipeline::GenerateElevationTile(const FSurvivalTerrainTile& Tile, const FSurvivalInfluenceField& Influence, const FSurvivalTerrainElevationSettings& Settings, FSurvivalElevationField& Field) const
+{
+    const FSurvivalTerrainGrid& Grid = Field.Grid;
+    const int32 SpanWidth = Tile.GetWidth();
+
+    TArray<float> WorldX, WorldY, HillNoise, TransitionNoise, NoiseVariation;
+    WorldX.SetNumUninitialized(SpanWidth);
+    WorldY.SetNumUninitialized(SpanWidth);
+    HillNoise.SetNumZeroed(SpanWidth);
+    TransitionNoise.SetNumZeroed(SpanWidth);
+    NoiseVariation.SetNumUninitialized(SpanWidth);
+
+    for (int32 X = Tile.MinX; X < Tile.MaxX; X++)
+    {
+        WorldX[X - Tile.MinX] = Grid.TexelToWorldX(X);
+    }
+
+    // Biome noise stays single-octave; only the course-wide variation is fractal
+    const FSurvivalFractalNoise BiomeNoise(Settings.Seed);
+    const FSurvivalFractalNoise VariationNoise(Settings.Seed, Settings.NoiseOctaves);
+
+    const float* SummedPlanes[NumBiomeTypes];
+    for (int32 BiomeIndex = 0; BiomeIndex < NumBiomeTypes; BiomeIndex++)
+    {
+        SummedPlanes[BiomeIndex] = Influence.GetSummedPlane(static_cast<EBiomeType>(BiomeIndex));
+    }
+
+    for (int32 Y = Tile.MinY; Y < Tile.MaxY; Y++)
+    {
+        const float RowWorldY = Grid.TexelToWorldY(Y);
+        const int32 RowOffset = Grid.TexelIndex(Tile.MinX, Y);
+        for (int32 Index = 0; Index < SpanWidth; Index++)
+        {
+            WorldY[Index] = RowWorldY;
+        }
+
+        // Forest hills and transition blending each need their own noise octave; skip them on rows without such influence
+        const float* ForestRow = SummedPlanes[int32(EBiomeType::Forest)] + RowOffset;
+        const float* TransitionRow = SummedPlanes[int32(EBiomeType::Transition)] + RowOffset;
+        bool bNeedsHillNoise = false;
+        bool bNeedsTransitionNoise = false;
+        for (int32 Index = 0; Index < SpanWidth; Index++)
+        {
+            bNeedsHillNoise |= ForestRow[Index] > 0.0f;
+            bNeedsTransitionNoise |= TransitionRow[Index] > 0.0f;
+        }
+
+        if (bNeedsHillNoise)
+        {
+            BiomeNoise.SampleBatch(WorldX.GetData(), WorldY.GetData(), HillNoiseScale, 1.0f, HillNoise.GetData(), SpanWidth);
+        }
+        if (bNeedsTransitionNoise)
+        {
+            BiomeNoise.SampleBatch(WorldX.GetData(), WorldY.GetData(), TransitionNoiseScale, 1.0f, TransitionNoise.GetData(), SpanWidth);
+        }
+
+        // Add natural terrain variation with Perlin noise
+        VariationNoise.SampleBatch(WorldX.GetData(), WorldY.GetData(), Settings.NoiseScale, Settings.NoiseAmplitude, NoiseVariation.GetData(), SpanWidth);
+
+        const float* AlpineCoreRow = Influence.AlpineCoreInfluence.GetData() + RowOffset;
+        float* RowOut = Field.Elevation.GetData() + RowOffset;
+        for (int32 Index = 0; Index < SpanWidth; Index++)
+        {
+            float WeightedElevation = 0.0f;
+            float TotalInfluence = 0.0f;
+
+            for (int32 BiomeIndex = 0; BiomeIndex < NumBiomeTypes; BiomeIndex++)
+            {
+                const float BiomeInfluence = SummedPlanes[BiomeIndex][RowOffset + Index];
+                if (BiomeInfluence > 0.0f)
+                {
+                    // Alpine elevation is linear in the core factor, so the influence-weighted mean of all
+                    // Alpine zones equals the per-zone blend
+                    const EBiomeType BiomeType = static_cast<EBiomeType>(BiomeIndex);
+                    const float CoreInfluence = BiomeType == EBiomeType::Alpine ? AlpineCoreRow[Index] / BiomeInfluence : 0.0f;
+
+                    WeightedElevation += CalculateBiomeElevation(BiomeType, WorldX[Index], RowWorldY, CoreInfluence, HillNoise[Index], TransitionNoise[Index]) * BiomeInfluence;
+                    TotalInfluence += BiomeInfluence;
+                }
+            }
+
+            const float TexelElevation = TotalInfluence > 0.0f ? WeightedElevation / TotalInfluence : DefaultElevation;
+            RowOut[Index] = FMath::Clamp(TexelElevation + NoiseVariation[Index], 0.0f, Settings.MaxElevation);
+        }
+    }
+}
+
+void FSurvivalTerrainPipeline::GenerateSlopeTile(const FSurvivalTerrainTile& Tile, const FSurvivalElevationField& Elevation, FSurvivalSlopeField& Field) const
+{
+    const FSurvivalTerrainGrid& Grid = Field.Grid;
+    const int32 Resolution = Grid.Resolution;
+    const float TexelSizeX = float(Grid.WorldExtent.X) / (Resolution - 1);
+    const float TexelSizeY = float(Grid.WorldExtent.Y) / (Resolution - 1);
+    const float* Heights = Elevation.Elevation.GetData();
+
+    for (int32 Y = Tile.MinY; Y < Tile.MaxY; Y++)
+    {
+        // One-sided differences on the outer rows and columns
+        const int32 Y0 = FMath::Max(Y - 1, 0);
+        const int32 Y1 = FMath::Min(Y + 1, Resolution - 1);
+
+        for (int32 X = Tile.MinX; X < Tile.MaxX; X++)
+        {
+            const int32 X0 = FMath::Max(X - 1, 0);
+            const int32 X1 = FMath::Min(X + 1, Resolution - 1);
+
+            const float GradientX = (Heights[Grid.TexelIndex(X1, Y)] - Heights[Grid.TexelIndex(X0, Y)]) / ((X1 - X0) * TexelSizeX);
+            const float GradientY = (Heights[Grid.TexelIndex(X, Y1)] - Heights[Grid.TexelIndex(X, Y0)]) / ((Y1 - Y0) * TexelSizeY);
+
+            Field.SlopeDegrees[Grid.TexelIndex(X, Y)] = FMath::RadiansToDegrees(FMath::Atan(FMath::Sqrt(GradientX * GradientX + GradientY * GradientY)));
+        }
+    }
+}
+
+void FSurvivalTerrainPipeline::GenerateLayerWeightsTile(const FSurvivalTerrainTile& Tile, const FSurvivalInfluenceField& Influence, const FSurvivalElevationField* Elevation,
+                                                         const FSurvivalSlopeField* Slope, const FSurvivalTerrainLayerSettings& Settings, FSurvivalLayerWeights& Weights) const
+{
+    const FSurvivalTerrainGrid& Grid = Weights.Grid;
+    const int32 NumLayers = Settings.LayerBiomes.Num();
+    const int32 TileWidth = Tile.GetWidth();
+    const bool bAltitudeBlending = Settings.bUseAltitudeBlending && Elevation && Slope;
+
+    TArray<const float*, TInlineAllocator<8>> PeakPlanes;
+    for (int32 LayerIndex = 0; LayerIndex < NumLayers; LayerIndex++)
+    {
+        PeakPlanes.Add(Influence.GetPeakPlane(Settings.LayerBiomes[LayerIndex]));
+    }
+
+    // Boosted influences of one tile row per layer
+    TArray<float> RowInfluences;
+    TArray<const float*, TInlineAllocator<8>> RowInfluencePlanes;
+    TArray<uint8*, TInlineAllocator<8>> RowOut;
+    RowInfluences.SetNumUninitialized(NumLayers * TileWidth);
+    RowOut.SetNumUninitialized(NumLayers);
+    for (int32 LayerIndex = 0; LayerIndex < NumLayers; LayerIndex++)
+    {
+        RowInfluencePlanes.Add(RowInfluences.GetData() + LayerIndex * TileWidth);
+    }
+
+    for (int32 Y = Tile.MinY; Y < Tile.MaxY; Y++)
+    {
+        const int32 RowStart = Grid.TexelIndex(Tile.MinX, Y);
+        const float* AltitudeRow = bAltitudeBlending ? Elevation->Elevation.GetData() + RowStart : nullptr;
+        const float* SlopeRow = bAltitudeBlending ? Slope->SlopeDegrees.GetData() + RowStart : nullptr;
+
+        for (int32 LayerIndex = 0; LayerIndex < NumLayers; LayerIndex++)
+        {
+            const EBiomeType BiomeType = Settings.LayerBiomes[LayerIndex];
+            const float* PeakRow = PeakPlanes[LayerIndex] + RowStart;
+            float* InfluenceRow = RowInfluences.GetData() + LayerIndex * TileWidth;
+
+            if (bAltitudeBlending)
+            {
+                for (int32 Column = 0; Column < TileWidth; Column++)
+                {
+                    InfluenceRow[Column] = PeakRow[Column] * GetTerrainBoost(BiomeType, AltitudeRow[Column], SlopeRow[Column]);
+                }
+            }
+            else
+            {
+                FMemory::Memcpy(InfluenceRow, PeakRow, TileWidth * sizeof(float));
+            }
+            RowOut[LayerIndex] = Weights.Layers[LayerIndex].GetData() + RowStart;
+        }
+
+        if (Settings.bNormalizeWeights)
+        {
+            // Boosts only change the layers' proportions; normalizing keeps them instead of clamping at 1
+            FSurvivalTerrainKernels::NormalizeWeightsBatch(RowInfluencePlanes.GetData(), NumLayers, RowOut.GetData(), TileWidth);
+            continue;
+        }
+
+        for (int32 LayerIndex = 0; LayerIndex < NumLayers; LayerIndex++)
+        {
+            for (int32 Column = 0; Column < TileWidth; Column++)
+            {
+                RowOut[LayerIndex][Column] = InfluenceToWeightValue(RowInfluencePlanes[LayerIndex][Column]);
+            }
+        }
+    }
+}
+
+float FSurvivalTerrainPipeline::GetTerrainBoost(EBiomeType BiomeType, float Altitude, float SlopeDegrees)
+{
+    switch (BiomeType)
+    {
+        case EBiomeType::Alpine:
+        {
+            // Alpine textures more prominent at high altitude
+            float Boost = 1.0f;
+            if (Altitude > 800.0f)
+            {
+                Boost += (Altitude - 800.0f) / 600.0f; // Boost above 800m
+            }
+
+            // Bare rock on cliffs and steep faces at any altitude
+            if (SlopeDegrees > 35.0f)
+            {
+                Boost *= 1.0f + FMath::Min((SlopeDegrees - 35.0f) / 20.0f, 1.0f);
+            }
+            return Boost;
+        }
+
+        case EBiomeType::River:
+        {
+            // River textures more prominent at low altitude
+            float Boost = Altitude < 400.0f ? 1.5f : 1.0f; // Boost below 400m
+
+            // Water and silt don't stay on steep banks
+            if (SlopeDegrees > 15.0f)
+            {
+                Boost *= FMath::Max(1.0f - (SlopeDegrees - 15.0f) / 15.0f, 0.0f);
+            }
+            return Boost;
+        }
+
+        case EBiomeType::Forest:
+            // Trees and undergrowth thin out on steep ground
+            return SlopeDegrees > 30.0f ? FMath::Max(1.0f - (SlopeDegrees - 30.0f) / 20.0f, 0.25f) : 1.0f;
+
+        default:
+            return 1.0f;
+    }
+}
+
+void FSurvivalTerrainPipeline::BlendLayerWeights(const FSurvivalTerrainRequest& Request, const FSurvivalTerrainTile& Region, const FSurvivalLayerWeights& RawWeights, FSurvivalLayerWeights& Weights) const
+{
+    const FSurvivalTerrainGrid& Grid = Weights.Grid;
+    const FSurvivalTerrainTile& Window = Grid.Window;
+    const int32 KernelSize = GetBlendKernelSize(Request);
+    const float BlendSmoothness = Request.Layers.BlendSmoothness;
+    const bool bNormalizeWeights = Request.Layers.bNormalizeWeights;
+    const int32 NumLayers = Weights.Layers.Num();
+    FSurvivalTerrainJob* Job = Request.Job.Get();
+
+    // The column pass reads row sums up to KernelSize rows above and below the region
+    const int32 RowMin = FMath::Max(Region.MinY - KernelSize, Window.MinY);
+    const int32 RowMax = FMath::Min(Region.MaxY + KernelSize, Window.MaxY);
+    const int32 RegionWidth = Region.GetWidth();
+    const int32 PlaneSize = RegionWidth * (RowMax - RowMin);
+
+    // Full-width row bands for the row pass and full-height column bands for the column pass, so each
+    // band only pays for filling its first window once
+    auto BuildBands = [&Request](const FSurvivalTerrainTile& Area, bool bRowBands, TArray<FSurvivalTerrainTile>& OutBands)
+    {
+        OutBands.Reset();
+        if (!Request.bUseTiledGeneration)
+        {
+            OutBands.Add(Area);
+            return;
+        }
+
+        const int32 BandSize = FMath::Max(Request.TileSize, 1);
+        const int32 Extent = bRowBands ? Area.GetHeight() : Area.GetWidth();
+        for (int32 Offset = 0; Offset < Extent; Offset += BandSize)
+        {
+            const int32 End = FMath::Min(Offset + BandSize, Extent);
+            OutBands.Add(bRowBands ? FSurvivalTerrainTile(Area.MinX, Area.MinY + Offset, Area.MaxX, Area.MinY + End)
+                                   : FSurvivalTerrainTile(Area.MinX + Offset, Area.MinY, Area.MinX + End, Area.MaxY));
+        }
+    };
+
+    // Pass 1: sum of each texel's row window, one plane per layer
+    TArray<uint16> RowSums;
+    RowSums.SetNumUninitialized(NumLayers * PlaneSize);
+
+    TArray<FSurvivalTerrainTile> Bands;
+    BuildBands(FSurvivalTerrainTile(Region.MinX, RowMin, Region.MaxX, RowMax), true, Bands);
+    FSurvivalTerrainTiling::ParallelForEachTile(Bands, [&](const FSurvivalTerrainTile& Band)
+    {
+        if (Job && Job->IsCancelled())
+        {
+            return;
+        }
+
+        const int32 FirstX = FMath::Max(Region.MinX - KernelSize, Window.MinX);
+        const int32 LastX = FMath::Min(Region.MinX + KernelSize, Window.MaxX - 1);
+
+        for (int32 LayerIndex = 0; LayerIndex < NumLayers; LayerIndex++)
+        {
+            for (int32 Y = Band.MinY; Y < Band.MaxY; Y++)
+            {
+                const uint8* RawRow = RawWeights.Layers[LayerIndex].GetData() + Grid.TexelIndex(Window.MinX, Y) - Window.MinX;
+                uint16* SumRow = RowSums.GetData() + LayerIndex * PlaneSize + (Y - RowMin) * RegionWidth - Region.MinX;
+
+                int32 Sum = 0;
+                for (int32 X = FirstX; X <= LastX; X++)
+                {
+                    Sum += RawRow[X];
+                }
+
+                for (int32 X = Region.MinX; X < Region.MaxX; X++)
+                {
+                    SumRow[X] = static_cast<uint16>(Sum);
+
+                    // Slide the window one texel right
+                    if (X + KernelSize + 1 < Window.MaxX)
+                    {
+                        Sum += RawRow[X + KernelSize + 1];
+                    }
+                    if (X - KernelSize >= Window.MinX)
+                    {
+                        Sum -= RawRow[X - KernelSize];
+                    }
+                }
+            }
+        }
+    });
+
+    // Pass 2: running sums of the row sums down each column
+    BuildBands(Region, false, Bands);
+    FSurvivalTerrainTiling::ParallelForEachTile(Bands, [&](const FSurvivalTerrainTile& Band)
+    {
+        if (Job && Job->IsCancelled())
+        {
+            return;
+        }
+
+        const int32 BandWidth = Band.GetWidth();
+
+        // Texels each column's window covers after clipping at the grid edge
+        TArray<int32> ColumnCounts;
+        ColumnCounts.SetNumUninitialized(BandWidth);
+        for (int32 Column = 0; Column < BandWidth; Column++)
+        {
+            const int32 X = Band.MinX + Column;
+            ColumnCounts[Column] = FMath::Min(X + KernelSize, Window.MaxX - 1) - FMath::Max(X - KernelSize, Window.MinX) + 1;
+        }
+
+        // Window sum per column and layer, layer-minor so all weights of a texel are finished (and packed) together
+        TArray<int32> ColumnSums;
+        ColumnSums.SetNumZeroed(BandWidth * NumLayers);
+
+        auto AccumulateRow = [&](int32 Y, int32 Sign)
+        {
+            for (int32 LayerIndex = 0; LayerIndex < NumLayers; LayerIndex++)
+            {
+                const uint16* SumRow = RowSums.GetData() + LayerIndex * PlaneSize + (Y - RowMin) * RegionWidth + (Band.MinX - Region.MinX);
+                for (int32 Column = 0; Column < BandWidth; Column++)
+                {
+                    ColumnSums[Column * NumLayers + LayerIndex] += Sign * SumRow[Column];
+                }
+            }
+        };
+
+        for (int32 Y = RowMin; Y <= FMath::Min(Region.MinY + KernelSize, RowMax - 1); Y++)
+        {
+            AccumulateRow(Y, 1);
+        }
+
+        // Unquantized blended weights of one band row per layer, for the normalizing kernel
+        TArray<float> BlendedRow;
+        TArray<const float*, TInlineAllocator<8>> BlendedPlanes;
+        TArray<uint8*, TInlineAllocator<8>> RowOut;
+        RowOut.SetNumUninitialized(NumLayers);
+        if (bNormalizeWeights)
+        {
+            BlendedRow.SetNumUninitialized(NumLayers * BandWidth);
+            for (int32 LayerIndex = 0; LayerIndex < NumLayers; LayerIndex++)
+            {
+                BlendedPlanes.Add(BlendedRow.GetData() + LayerIndex * BandWidth);
+            }
+        }
+
+        for (int32 Y = Region.MinY; Y < Region.MaxY; Y++)
+        {
+            const int32 RowCount = FMath::Min(Y + KernelSize, Window.MaxY - 1) - FMath::Max(Y - KernelSize, Window.MinY) + 1;
+
+            if (bNormalizeWeights)
+            {
+                const int32 RowStart = Grid.TexelIndex(Band.MinX, Y);
+                for (int32 LayerIndex = 0; LayerIndex < NumLayers; LayerIndex++)
+                {
+                    const uint8* RawRow = RawWeights.Layers[LayerIndex].GetData() + RowStart;
+                    float* Blended = BlendedRow.GetData() + LayerIndex * BandWidth;
+                    for (int32 Column = 0; Column < BandWidth; Column++)
+                    {
+                        const float SmoothedValue = float(ColumnSums[Column * NumLayers + LayerIndex]) / float(ColumnCounts[Column] * RowCount);
+                        Blended[Column] = FMath::Lerp(float(RawRow[Column]), SmoothedValue, BlendSmoothness);
+                    }
+                    RowOut[LayerIndex] = Weights.Layers[LayerIndex].GetData() + RowStart;
+                }
+
+                // Box filtering keeps the sum of normalized weights, up to rounding; renormalizing restores it exactly
+                FSurvivalTerrainKernels::NormalizeWeightsBatch(BlendedPlanes.GetData(), NumLayers, RowOut.GetData(), BandWidth);
+
+                for (int32 Column = 0; Column < BandWidth; Column++)
+                {
+                    FColor& PackedTexel = Weights.PackedTexels[RowStart + Column];
+                    for (int32 LayerIndex = 0; LayerIndex < FMath::Min(NumLayers, FSurvivalLayerWeights::MaxPackedLayers); LayerIndex++)
+                    {
+                        FSurvivalLayerWeights::GetPackedChannel(PackedTexel, LayerIndex) = RowOut[LayerIndex][Column];
+                    }
+                }
+            }
+            else
+            {
+                for (int32 Column = 0; Column < BandWidth; Column++)
+                {
+                    const int32 TexelIndex = Grid.TexelIndex(Band.MinX + Column, Y);
+                    const int32 SampleCount = ColumnCounts[Column] * RowCount;
+                    FColor& PackedTexel = Weights.PackedTexels[TexelIndex];
+
+                    for (int32 LayerIndex = 0; LayerIndex < NumLayers; LayerIndex++)
+                    {
+                        // Apply smoothed value with blend factor
+                        const uint8 SmoothedValue = static_cast<uint8>(ColumnSums[Column * NumLayers + LayerIndex] / SampleCount);
+                        const uint8 OriginalValue = RawWeights.Layers[LayerIndex][TexelIndex];
+                        const uint8 BlendedValue = static_cast<uint8>(FMath::Lerp(OriginalValue, SmoothedValue, BlendSmoothness));
+
+                        Weights.Layers[LayerIndex][TexelIndex] = BlendedValue;
+                        if (LayerIndex < FSurvivalLayerWeights::MaxPackedLayers)
+                        {
+                            FSurvivalLayerWeights::GetPackedChannel(PackedTexel, LayerIndex) = BlendedValue;
+                        }
+                    }
+                }
+            }
+
+            // Slide the window one row down
+            if (Y + KernelSize + 1 < RowMax)
+            {
+                AccumulateRow(Y + KernelSize + 1, 1);
+            }
+            if (Y - KernelSize >= RowMin)
+            {
+                AccumulateRow(Y - KernelSize, -1);
+            }
+        }
+
+        if (Job)
+        {
+            Job->AddCompletedTexels(int64(BandWidth) * Band.GetHeight());
+        }
+    });
+}
+
+float FSurvivalTerrainPipeline::CalculateBiomeElevation(EBiomeType BiomeType, float WorldX, float WorldY, float CoreInfluence, float HillNoise, float TransitionNoise)
+{
+    switch (BiomeType)
+    {
+        case EBiomeType::Alpine:
+            // High elevation with steep gradients near center
+            return 800.0f + (600.0f * CoreInfluence); // 800-1400m elevation range
+
+        case EBiomeType::Forest:
+            // Rolling hills with moderate elevation
+            return 200.0f + (HillNoise * 300.0f); // 200-500m elevation range
+
+        case EBiomeType::River:
+            // Low elevation following valley path
+            {
+                float DistanceFromRiverPath = FVector2D::Distance(FVector2D(WorldX, WorldY), FVector2D(4000.0f, 1000.0f));
+                float ValleyDepth = FMath::Max(0.0f, 200.0f - (DistanceFromRiverPath * 0.1f));
+                return 100.0f + ValleyDepth; // 100-300m elevation range
+            }
+
+        case EBiomeType::Transition:
+            // Blend between adjacent biome elevations
+            return 400.0f + (TransitionNoise * 200.0f);
+
+        default:
+            return 300.0f; // Default moderate elevation
+    }
+}
+
+float FSurvivalTerrainPipeline::CalculateCoreInfluence(float DistanceFromCenter, float Radius)
+{
+    return 1.0f - FMath::Clamp(DistanceFromCenter / (Radius * 0.3f), 0.0f, 1.0f);
+}
+
+uint8 FSurvivalTerrainPipeline::InfluenceToWeightValue(float Influence)
+{
+    // Convert influence (0.0-1.0) to weight value (0-255)
+    Influence = FMath::Clamp(Influence, 0.0f, 1.0f);
+    return static_cast<uint8>(Influence * 255.0f);
+}
\ No newline at end of file
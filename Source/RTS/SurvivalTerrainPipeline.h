@@ -0,0 +1,434 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SurvivalBiomeZoneIndex.h"
+#include "SurvivalTerrainTiling.h"
+#include <atomic>
+
+struct FBiomeZone;
+struct FXxHash64Builder;
+enum class EBiomeType : uint8;
+
+enum class ESurvivalTerrainStage : uint8
+{
+    Influence,
+    Elevation,
+    Slope,
+    LayerWeights,
+    BorderBlend,
+
+    Num
+};
+
+// Texel grid every stage is sampled on: Resolution x Resolution texels spanning [0, WorldExtent]
+struct FSurvivalTerrainGrid
+{
+    int32 Resolution;
+    FVector2D WorldExtent;
+
+    // Texels a field on this grid stores; the whole grid except while streaming one tile at a time
+    FSurvivalTerrainTile Window;
+
+    FSurvivalTerrainGrid()
+        : Resolution(0), WorldExtent(FVector2D::ZeroVector)
+    {
+    }
+
+    FSurvivalTerrainGrid(int32 InResolution, const FVector2D& InWorldExtent)
+        : Resolution(InResolution), WorldExtent(InWorldExtent), Window(0, 0, InResolution, InResolution)
+    {
+    }
+
+    // Same grid storing only InWindow; texel coordinates (and so world positions) stay global
+    FSurvivalTerrainGrid GetWindowed(const FSurvivalTerrainTile& InWindow) const
+    {
+        FSurvivalTerrainGrid Windowed = *this;
+        Windowed.Window = InWindow;
+        return Windowed;
+    }
+
+    int32 NumTexels() const { return Window.GetWidth() * Window.GetHeight(); }
+    int32 TexelIndex(int32 X, int32 Y) const { return (Y - Window.MinY) * Window.GetWidth() + (X - Window.MinX); }
+    float TexelToWorldX(int32 X) const { return (X / float(Resolution - 1)) * float(WorldExtent.X); }
+    float TexelToWorldY(int32 Y) const { return (Y / float(Resolution - 1)) * float(WorldExtent.Y); }
+};
+
+// Stage 1. Per-biome-type influence planes; plane P covers texels [P * NumTexels, (P + 1) * NumTexels).
+struct FSurvivalInfluenceField
+{
+    FSurvivalTerrainGrid Grid;
+
+    // Sum of zone influences per biome type, the weights of the elevation blend
+    TArray<float> SummedInfluence;
+
+    // Strongest single zone influence per biome type, the basis of the texture layer weights
+    TArray<float> PeakInfluence;
+
+    // Sum over Alpine zones of influence * core factor; Alpine is the only biome whose elevation
+    // depends on the distance to its own zone center
+    TArray<float> AlpineCoreInfluence;
+
+    const float* GetSummedPlane(EBiomeType BiomeType) const { return SummedInfluence.GetData() + int32(BiomeType) * Grid.NumTexels(); }
+    const float* GetPeakPlane(EBiomeType BiomeType) const { return PeakInfluence.GetData() + int32(BiomeType) * Grid.NumTexels(); }
+};
+
+// Stage 2. World-space elevation in [0, MaxElevation]
+struct FSurvivalElevationField
+{
+    FSurvivalTerrainGrid Grid;
+    float MaxElevation;
+    TArray<float> Elevation;
+
+    FSurvivalElevationField()
+        : MaxElevation(0.0f)
+    {
+    }
+};
+
+// Stage 3. Terrain slope in degrees from central differences of the elevation
+struct FSurvivalSlopeField
+{
+    FSurvivalTerrainGrid Grid;
+    TArray<float> SlopeDegrees;
+};
+
+// Stages 4 and 5. One 0-255 weight plane per texture layer, raw or border blended.
+struct FSurvivalLayerWeights
+{
+    // Channels of a landscape weightmap texel
+    static constexpr int32 MaxPackedLayers = 4;
+
+    FSurvivalTerrainGrid Grid;
+    TArray<EBiomeType> LayerBiomes;
+    TArray<TArray<uint8>> Layers;
+
+    // Border blended stage only: the first MaxPackedLayers layers interleaved as R, G, B, A, one FColor per
+    // texel, ready for a weightmap texture. Channels without a layer are 0.
+    TArray<FColor> PackedTexels;
+
+    static uint8& GetPackedChannel(FColor& Texel, int32 LayerIndex)
+    {
+        uint8* Channels[MaxPackedLayers] = { &Texel.R, &Texel.G, &Texel.B, &Texel.A };
+        return *Channels[LayerIndex];
+    }
+};
+
+struct FSurvivalTerrainElevationSettings
+{
+    float NoiseScale;
+    float NoiseAmplitude;
+    float MaxElevation;
+
+    // Course seed for every noise octave (see FSurvivalNoisePermutation); 0 is the original unseeded course
+    uint32 Seed;
+
+    // fBm octaves of the terrain variation noise; 1 is plain gradient noise
+    int32 NoiseOctaves;
+
+    FSurvivalTerrainElevationSettings()
+        : NoiseScale(0.001f), NoiseAmplitude(100.0f), MaxElevation(2000.0f), Seed(0), NoiseOctaves(1)
+    {
+    }
+};
+
+struct FSurvivalTerrainLayerSettings
+{
+    TArray<EBiomeType> LayerBiomes;
+
+    // Scale layers by the elevation and slope under each texel (see FSurvivalTerrainPipeline::GetTerrainBoost).
+    // Runs the request's elevation settings, so they should match the heightmap's to share its cached stages.
+    bool bUseAltitudeBlending;
+    float BlendSmoothness;
+
+    // Half-width of the border smoothing window in texels (3 = 7x7), up to FSurvivalTerrainPipeline::MaxBlendKernelSize
+    int32 BlendKernelSize;
+
+    // Raw and blended weights of every texel sum to exactly 255 (see FSurvivalTerrainKernels::NormalizeWeightsBatch)
+    // instead of each layer saturating on its own; texels no zone reaches stay 0
+    bool bNormalizeWeights;
+
+    FSurvivalTerrainLayerSettings()
+        : bUseAltitudeBlending(true), BlendSmoothness(0.8f), BlendKernelSize(3), bNormalizeWeights(false)
+    {
+    }
+};
+
+// Cancellation and progress of one Run, shared with whoever launched it. Run polls it between tiles.
+class RTS_API FSurvivalTerrainJob
+{
+public:
+    FSurvivalTerrainJob();
+
+    // Remaining tiles are skipped and Run returns an empty result; nothing partial reaches the stage caches
+    void Cancel() { bCancelled = true; }
+    bool IsCancelled() const { return bCancelled; }
+
+    // 0-1 over every texel of every stage the request runs
+    float GetProgress() const;
+
+    // Called from worker threads each time progress crosses another ProgressStep
+    TFunction<void(float)> OnProgress;
+
+    static constexpr float ProgressStep = 0.05f;
+
+private:
+    friend class FSurvivalTerrainPipeline;
+
+    void Begin(int64 InTotalTexels);
+    void AddCompletedTexels(int64 NumTexels);
+
+    std::atomic<bool> bCancelled;
+    std::atomic<int64> CompletedTexels;
+    std::atomic<int32> LastReportedStep;
+    int64 TotalTexels;
+};
+
+// What a consumer needs from the pipeline. The influence field is always produced; the other
+// stages only run when requested (slope implies elevation; altitude blended layer weights imply slope).
+struct FSurvivalTerrainRequest
+{
+    FSurvivalTerrainGrid Grid;
+
+    // Tiling only changes how work is spread over threads, never the output, so it is not part of any cache key
+    bool bUseTiledGeneration;
+    int32 TileSize;
+
+    bool bGenerateElevation;
+    bool bGenerateSlope;
+    bool bGenerateLayerWeights;
+
+    FSurvivalTerrainElevationSettings Elevation;
+    FSurvivalTerrainLayerSettings Layers;
+
+    // Optional cancellation and progress reporting
+    TSharedPtr<FSurvivalTerrainJob> Job;
+
+    FSurvivalTerrainRequest()
+        : bUseTiledGeneration(true)
+        , TileSize(FSurvivalTerrainTiling::DefaultTileSize)
+        , bGenerateElevation(false)
+        , bGenerateSlope(false)
+        , bGenerateLayerWeights(false)
+    {
+    }
+};
+
+// Stage outputs are immutable once produced and shared between the cache and every consumer
+struct FSurvivalTerrainResult
+{
+    TSharedPtr<const FSurvivalInfluenceField> Influence;
+    TSharedPtr<const FSurvivalElevationField> Elevation;
+    TSharedPtr<const FSurvivalSlopeField> Slope;
+    TSharedPtr<const FSurvivalLayerWeights> RawLayerWeights;
+    TSharedPtr<const FSurvivalLayerWeights> BlendedLayerWeights;
+
+    // Wall time each stage took in this Run, indexed by ESurvivalTerrainStage; near zero for cache hits
+    // and zero for stages the request did not run. Stages running side by side overlap.
+    double StageSeconds[int32(ESurvivalTerrainStage::Num)];
+
+    // Stages that patched an earlier output after zone edits instead of generating the whole grid
+    bool StagePatched[int32(ESurvivalTerrainStage::Num)];
+
+    FSurvivalTerrainResult()
+    {
+        for (double& Seconds : StageSeconds)
+        {
+            Seconds = 0.0;
+        }
+        for (bool& bPatched : StagePatched)
+        {
+            bPatched = false;
+        }
+    }
+
+    double GetStageSeconds(ESurvivalTerrainStage Stage) const { return StageSeconds[int32(Stage)]; }
+
+    // True when any stage came from an incremental zone edit; the output is the same, but it is a
+    // transient layout consumers needn't persist
+    bool WasPatched() const
+    {
+        for (bool bPatched : StagePatched)
+        {
+            if (bPatched)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+// Most recently used outputs of one stage, keyed by the content hash of everything the stage reads
+template<typename OutputType>
+struct TSurvivalTerrainStageCache
+{
+    struct FEntry
+    {
+        uint64 InputHash;
+        // Input hash with the zone layout left out; an entry with equal settings can be patched after a zone edit
+        uint64 SettingsHash;
+        int32 ZoneRevision;
+        // Produced by patching an earlier output, so hits report it the same way
+        bool bPatched;
+        TSharedPtr<const OutputType> Output;
+    };
+
+    static constexpr int32 MaxEntries = 2;
+
+    TArray<FEntry> Entries;
+
+    TSharedPtr<const OutputType> Find(uint64 InputHash, bool& bOutPatched)
+    {
+        for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); EntryIndex++)
+        {
+            if (Entries[EntryIndex].InputHash == InputHash)
+            {
+                FEntry Entry = MoveTemp(Entries[EntryIndex]);
+                Entries.RemoveAt(EntryIndex);
+                bOutPatched = Entry.bPatched;
+                return Entries.Add_GetRef(MoveTemp(Entry)).Output;
+            }
+        }
+        return nullptr;
+    }
+
+    const FEntry* FindPatchable(uint64 SettingsHash) const
+    {
+        for (int32 EntryIndex = Entries.Num() - 1; EntryIndex >= 0; EntryIndex--)
+        {
+            if (Entries[EntryIndex].SettingsHash == SettingsHash)
+            {
+                return &Entries[EntryIndex];
+            }
+        }
+        return nullptr;
+    }
+
+    void Add(uint64 InputHash, uint64 SettingsHash, int32 ZoneRevision, bool bPatched, TSharedPtr<const OutputType> Output)
+    {
+        if (Entries.Num() >= MaxEntries)
+        {
+            Entries.RemoveAt(0);
+        }
+        Entries.Add({ InputHash, SettingsHash, ZoneRevision, bPatched, MoveTemp(Output) });
+    }
+};
+
+// Shared terrain generation: biome influence field -> elevation -> slope, and influence field (plus
+// elevation and slope when altitude blending) -> layer weights -> border blend. Each stage's output is cached by a content hash of its inputs, so
+// the biome manager, landscape manager and texture blender reuse one influence field instead of
+// each recomputing it. Independent stages run concurrently on the task graph. After a zone edit,
+// a cached output with the same settings is patched in the dirty region rather than rebuilt.
+// Run is not reentrant and SetBiomeZones must not overlap it; background jobs run on a copy of the
+// pipeline (stage outputs are shared, not duplicated, by the copy).
+class RTS_API FSurvivalTerrainPipeline
+{
+public:
+    // Alpine, Forest, River, Transition
+    static constexpr int32 NumBiomeTypes = 4;
+
+    // Widest border smoothing window; a row sum of 2 * 127 + 1 weights still fits in 16 bits
+    static constexpr int32 MaxBlendKernelSize = 127;
+
+    // Noise octaves of the per-biome elevation model
+    static constexpr float HillNoiseScale = 0.0005f;
+    static constexpr float TransitionNoiseScale = 0.001f;
+
+    // Elevation of texels no biome zone reaches
+    static constexpr float DefaultElevation = 200.0f;
+
+    FSurvivalTerrainPipeline();
+
+    // Replaces the zone layout. DirtyWorldBounds covers every location whose influence may differ
+    // from the previous layout; invalid bounds mean everything changed.
+    void SetBiomeZones(const TArray<FBiomeZone>& Zones, const FBox2D& DirtyWorldBounds);
+
+    // Returns an empty result when Request.Job is cancelled
+    FSurvivalTerrainResult Run(const FSurvivalTerrainRequest& Request);
+
+    // Elevation for Tiles of Request.Grid without going through the stage caches, for grids too large to
+    // hold in memory. Each tile gets its own windowed influence and elevation fields, handed to
+    // OnTileGenerated on a worker thread and released right after, so at most one tile per worker is alive.
+    // Output matches Run texel for texel.
+    void GenerateElevationTiles(const FSurvivalTerrainRequest& Request, const TArray<FSurvivalTerrainTile>& Tiles,
+                                TFunctionRef<void(const FSurvivalTerrainTile&, const FSurvivalElevationField&)> OnTileGenerated) const;
+
+    // Content hash of a stage's output for Request under the current zone layout, without running anything.
+    // Stable across sessions, so it can key caches that outlive the process.
+    uint64 GetStageHash(const FSurvivalTerrainRequest& Request, ESurvivalTerrainStage Stage) const;
+
+    void ResetCache();
+
+    // Elevation one zone of BiomeType contributes at a location. CoreInfluence is the zone's core
+    // factor (see CalculateCoreInfluence) and only matters for Alpine.
+    static float CalculateBiomeElevation(EBiomeType BiomeType, float WorldX, float WorldY, float CoreInfluence, float HillNoise, float TransitionNoise);
+
+    // 1 at a zone center falling to 0 at 30% of its radius
+    static float CalculateCoreInfluence(float DistanceFromCenter, float Radius);
+
+    // Factor altitude blending applies to a layer's influence at a texel with this elevation and slope
+    static float GetTerrainBoost(EBiomeType BiomeType, float Altitude, float SlopeDegrees);
+
+    // Converts influence (0.0-1.0) to a layer weight (0-255)
+    static uint8 InfluenceToWeightValue(float Influence);
+
+private:
+    struct FStageKey
+    {
+        uint64 InputHash;
+        uint64 SettingsHash;
+    };
+
+    struct FStageKeys
+    {
+        FStageKey Influence;
+        FStageKey Elevation;
+        FStageKey Slope;
+        FStageKey LayerWeights;
+        FStageKey BorderBlend;
+    };
+
+    // Key of a stage whose inputs are Upstream's output plus whatever AppendSettings hashes
+    static FStageKey ChainKey(const FStageKey& Upstream, TFunctionRef<void(FXxHash64Builder&)> AppendSettings);
+
+    FStageKeys ComputeStageKeys(const FSurvivalTerrainRequest& Request) const;
+
+    // Returns null when Job is cancelled while the stage runs. bOutPatched is set when the output, or the cached
+    // output it reuses, only had a dirty region regenerated.
+    template<typename OutputType>
+    TSharedPtr<const OutputType> RunStage(TSurvivalTerrainStageCache<OutputType>& Cache, const FStageKey& Key, const FSurvivalTerrainGrid& Grid, int32 GrowTexels, FSurvivalTerrainJob* Job, bool& bOutPatched,
+                                          TFunctionRef<void(OutputType&)> Allocate, TFunctionRef<void(const FSurvivalTerrainTile&, OutputType&)> Generate);
+
+    // Texels that may differ between the zone layout at Revision and the current one, grown by GrowTexels.
+    // Returns false when the change history doesn't reach back that far or includes a full invalidation.
+    bool GetDirtyRegionSince(int32 Revision, const FSurvivalTerrainGrid& Grid, int32 GrowTexels, FSurvivalTerrainTile& OutRegion) const;
+
+    void ForEachTile(const FSurvivalTerrainRequest& Request, const FSurvivalTerrainTile& Region, TFunctionRef<void(const FSurvivalTerrainTile&)> Body) const;
+
+    void GenerateInfluenceTile(const FSurvivalTerrainTile& Tile, const TArray<int32>& ZoneIndices, FSurvivalInfluenceField& Field) const;
+    void GenerateElevationTile(const FSurvivalTerrainTile& Tile, const FSurvivalInfluenceField& Influence, const FSurvivalTerrainElevationSettings& Settings, FSurvivalElevationField& Field) const;
+    void GenerateSlopeTile(const FSurvivalTerrainTile& Tile, const FSurvivalElevationField& Elevation, FSurvivalSlopeField& Field) const;
+    // Elevation and Slope are null unless the request uses altitude blending
+    void GenerateLayerWeightsTile(const FSurvivalTerrainTile& Tile, const FSurvivalInfluenceField& Influence, const FSurvivalElevationField* Elevation,
+                                  const FSurvivalSlopeField* Slope, const FSurvivalTerrainLayerSettings& Settings, FSurvivalLayerWeights& Weights) const;
+
+    static int32 GetBlendKernelSize(const FSurvivalTerrainRequest& Request) { return FMath::Clamp(Request.Layers.BlendKernelSize, 0, MaxBlendKernelSize); }
+
+    // Box filter of every layer over Region as two running-sum passes (rows, then columns), so the cost per
+    // texel doesn't depend on the kernel size. Windows are clipped at the grid edge.
+    void BlendLayerWeights(const FSurvivalTerrainRequest& Request, const FSurvivalTerrainTile& Region, const FSurvivalLayerWeights& RawWeights, FSurvivalLayerWeights& Weights) const;
+
+    FSurvivalBiomeZoneIndex ZoneIndex;
+    uint64 ZonesHash;
+
+    // Dirty bounds of each zone change, oldest first; ZoneChanges[I] moved revision FirstTrackedRevision + I to the next
+    int32 ZoneRevision;
+    int32 FirstTrackedRevision;
+    TArray<FBox2D> ZoneChanges;
+
+    TSurvivalTerrainStageCache<FSurvivalInfluenceField> InfluenceCache;
+    TSurvivalTerrainStageCache<FSurvivalElevationField> ElevationCache;
+    TSurvivalTerrainStageCache<FSurvivalSlopeField> SlopeCache;
+    TSurvivalTerrainStageCache<FSurvivalLayerWeights> LayerWeightsCache;
+    TSurvivalTerrainStageCache<FSurvivalLayerWeights> BlendedWeightsCache;
+};
\ No newline at end of file
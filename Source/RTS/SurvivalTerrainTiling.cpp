@@ -0,0 +1,98 @@
+#include "SurvivalTerrainTiling.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/IConsoleManager.h"
+#include <atomic>
+
+static TAutoConsoleVariable<int32> CVarTerrainGenerationThreads(
+    TEXT("rts.Terrain.GenerationThreads"),
+    0,
+    TEXT("Number of threads used for tiled terrain generation.\n")
+    TEXT(" 0: use every task graph worker plus the calling thread (default)\n")
+    TEXT(" 1: generate serially on the calling thread\n")
+    TEXT(">1: cap generation at this many threads"),
+    ECVF_Default);
+
+void FSurvivalTerrainTiling::BuildTiles(int32 Width, int32 Height, int32 TileSize, TArray<FSurvivalTerrainTile>& OutTiles)
+{
+    BuildTiles(FSurvivalTerrainTile(0, 0, Width, Height), TileSize, OutTiles);
+}
+
+void FSurvivalTerrainTiling::BuildTiles(const FSurvivalTerrainTile& Region, int32 TileSize, TArray<FSurvivalTerrainTile>& OutTiles)
+{
+    OutTiles.Reset();
+
+    if (Region.IsEmpty())
+    {
+        return;
+    }
+
+    TileSize = FMath::Max(TileSize, 1);
+    const int32 TilesX = FMath::DivideAndRoundUp(Region.GetWidth(), TileSize);
+    const int32 TilesY = FMath::DivideAndRoundUp(Region.GetHeight(), TileSize);
+    OutTiles.Reserve(TilesX * TilesY);
+
+    for (int32 TileY = 0; TileY < TilesY; TileY++)
+    {
+        for (int32 TileX = 0; TileX < TilesX; TileX++)
+        {
+            const int32 MinX = Region.MinX + TileX * TileSize;
+            const int32 MinY = Region.MinY + TileY * TileSize;
+            OutTiles.Emplace(MinX, MinY, FMath::Min(MinX + TileSize, Region.MaxX), FMath::Min(MinY + TileSize, Region.MaxY));
+        }
+    }
+}
+
+FSurvivalTerrainTile FSurvivalTerrainTiling::WorldBoundsToTexelRegion(const FBox2D& WorldBounds, const FVector2D& WorldExtent, int32 Width, int32 Height, int32 PaddingTexels)
+{
+    if (!WorldBounds.bIsValid || Width < 2 || Height < 2)
+    {
+        return FSurvivalTerrainTile(0, 0, Width, Height);
+    }
+
+    const double TexelsPerUnitX = (Width - 1) / FMath::Max(WorldExtent.X, UE_DOUBLE_SMALL_NUMBER);
+    const double TexelsPerUnitY = (Height - 1) / FMath::Max(WorldExtent.Y, UE_DOUBLE_SMALL_NUMBER);
+
+    const int32 MinX = FMath::FloorToInt32(WorldBounds.Min.X * TexelsPerUnitX) - PaddingTexels;
+    const int32 MinY = FMath::FloorToInt32(WorldBounds.Min.Y * TexelsPerUnitY) - PaddingTexels;
+    const int32 MaxX = FMath::CeilToInt32(WorldBounds.Max.X * TexelsPerUnitX) + 1 + PaddingTexels;
+    const int32 MaxY = FMath::CeilToInt32(WorldBounds.Max.Y * TexelsPerUnitY) + 1 + PaddingTexels;
+
+    FSurvivalTerrainTile Region(FMath::Clamp(MinX, 0, Width), FMath::Clamp(MinY, 0, Height), FMath::Clamp(MaxX, 0, Width), FMath::Clamp(MaxY, 0, Height));
+    return Region.IsEmpty() ? FSurvivalTerrainTile() : Region;
+}
+
+int32 FSurvivalTerrainTiling::GetNumGenerationThreads()
+{
+    const int32 Requested = CVarTerrainGenerationThreads.GetValueOnAnyThread();
+    if (Requested > 0)
+    {
+        return Requested;
+    }
+
+    // Task graph workers plus the thread that issued the ParallelFor
+    return FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+}
+
+void FSurvivalTerrainTiling::ParallelForEachTile(const TArray<FSurvivalTerrainTile>& Tiles, TFunctionRef<void(const FSurvivalTerrainTile&)> Body)
+{
+    const int32 NumWorkers = FMath::Min(GetNumGenerationThreads(), Tiles.Num());
+
+    if (NumWorkers <= 1)
+    {
+        for (const FSurvivalTerrainTile& Tile : Tiles)
+        {
+            Body(Tile);
+        }
+        return;
+    }
+
+    std::atomic<int32> NextTile(0);
+    ParallelFor(NumWorkers, [&Tiles, &Body, &NextTile](int32 WorkerIndex)
+    {
+        for (int32 TileIndex = NextTile++; TileIndex < Tiles.Num(); TileIndex = NextTile++)
+        {
+            Body(Tiles[TileIndex]);
+        }
+    });
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Rectangular block of heightmap/weightmap texels. Min is inclusive, Max is exclusive.
+struct FSurvivalTerrainTile
+{
+    int32 MinX;
+    int32 MinY;
+    int32 MaxX;
+    int32 MaxY;
+
+    FSurvivalTerrainTile()
+        : MinX(0), MinY(0), MaxX(0), MaxY(0)
+    {
+    }
+
+    FSurvivalTerrainTile(int32 InMinX, int32 InMinY, int32 InMaxX, int32 InMaxY)
+        : MinX(InMinX), MinY(InMinY), MaxX(InMaxX), MaxY(InMaxY)
+    {
+    }
+
+    int32 GetWidth() const { return MaxX - MinX; }
+    int32 GetHeight() const { return MaxY - MinY; }
+    bool IsEmpty() const { return MaxX <= MinX || MaxY <= MinY; }
+};
+
+// Shared helpers for splitting terrain buffers into cache-sized tiles and processing them in parallel
+struct RTS_API FSurvivalTerrainTiling
+{
+    // 64x64 texels keeps a uint16 tile (8KB) plus the culled zone list resident in L1/L2
+    static constexpr int32 DefaultTileSize = 64;
+
+    static void BuildTiles(int32 Width, int32 Height, int32 TileSize, TArray<FSurvivalTerrainTile>& OutTiles);
+    static void BuildTiles(const FSurvivalTerrainTile& Region, int32 TileSize, TArray<FSurvivalTerrainTile>& OutTiles);
+
+    // Texels of a Width x Height grid spanning [0, WorldExtent] touched by WorldBounds, grown by PaddingTexels.
+    // An invalid WorldBounds means "everything" and returns the whole grid.
+    static FSurvivalTerrainTile WorldBoundsToTexelRegion(const FBox2D& WorldBounds, const FVector2D& WorldExtent, int32 Width, int32 Height, int32 PaddingTexels = 1);
+
+    // Number of workers requested through rts.Terrain.GenerationThreads (0 = all task graph workers)
+    static int32 GetNumGenerationThreads();
+
+    // Runs Body once per tile. Workers pull tiles from a shared counter so dense biome areas don't stall a thread.
+    static void ParallelForEachTile(const TArray<FSurvivalTerrainTile>& Tiles, TFunctionRef<void(const FSurvivalTerrainTile&)> Body);
+};
\ No newline at end of file
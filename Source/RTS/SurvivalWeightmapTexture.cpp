@@ -0,0 +1,240 @@
+#include "SurvivalWeightmapTexture.h"
+#include "Engine/Texture2D.h"
+#include "Misc/App.h"
+#include "TextureResource.h"
+
+FSurvivalWeightmapMipChain::FSurvivalWeightmapMipChain()
+    : Width(0)
+    , Height(0)
+{
+}
+
+int32 FSurvivalWeightmapMipChain::GetNumMips(int32 InWidth, int32 InHeight)
+{
+    return FMath::FloorLog2(FMath::Max(FMath::Max(InWidth, InHeight), 1)) + 1;
+}
+
+bool FSurvivalWeightmapMipChain::HasDirtyRegions() const
+{
+    for (const TArray<FSurvivalTerrainTile>& MipRegions : DirtyRegions)
+    {
+        if (MipRegions.Num() > 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+TSharedRef<FSurvivalWeightmapMipChain> FSurvivalWeightmapMipChain::Build(const FSurvivalWeightmapMipChain* Previous, TArray<FColor>&& Texels, int32 InWidth, int32 InHeight)
+{
+    check(Texels.Num() == InWidth * InHeight);
+
+    TSharedRef<FSurvivalWeightmapMipChain> Chain = MakeShared<FSurvivalWeightmapMipChain>();
+    Chain->Width = InWidth;
+    Chain->Height = InHeight;
+
+    const int32 NumMips = GetNumMips(InWidth, InHeight);
+    Chain->DirtyRegions.SetNum(NumMips);
+
+    TArray<FSurvivalTerrainTile> Tiles;
+    FSurvivalTerrainTiling::BuildTiles(InWidth, InHeight, UploadTileSize, Tiles);
+
+    // Mip 0: the new texels, and the tiles that differ from the previous chain
+    TArray<bool> TileChanged;
+    TileChanged.Init(true, Tiles.Num());
+    if (Previous && Previous->Width == InWidth && Previous->Height == InHeight && Previous->Mips.Num() == NumMips)
+    {
+        const FColor* OldTexels = Previous->Mips[0].GetData();
+        FSurvivalTerrainTiling::ParallelForEachTile(Tiles, [&](const FSurvivalTerrainTile& Tile)
+        {
+            bool bChanged = false;
+            for (int32 Y = Tile.MinY; Y < Tile.MaxY && !bChanged; Y++)
+            {
+                const int32 RowStart = Y * InWidth + Tile.MinX;
+                bChanged = FMemory::Memcmp(OldTexels + RowStart, Texels.GetData() + RowStart, Tile.GetWidth() * sizeof(FColor)) != 0;
+            }
+            TileChanged[&Tile - Tiles.GetData()] = bChanged;
+        });
+
+        // Unchanged tiles keep the previous mip texels
+        Chain->Mips = Previous->Mips;
+    }
+    else
+    {
+        Chain->Mips.SetNum(NumMips);
+        for (int32 MipIndex = 1; MipIndex < NumMips; MipIndex++)
+        {
+            Chain->Mips[MipIndex].SetNumUninitialized(FMath::Max(InWidth >> MipIndex, 1) * FMath::Max(InHeight >> MipIndex, 1));
+        }
+    }
+    Chain->Mips[0] = MoveTemp(Texels);
+
+    for (int32 TileIndex = 0; TileIndex < Tiles.Num(); TileIndex++)
+    {
+        if (TileChanged[TileIndex])
+        {
+            Chain->DirtyRegions[0].Add(Tiles[TileIndex]);
+        }
+    }
+
+    // Each further mip: the tiles of its own grid that lie above a dirty region of the mip below
+    for (int32 MipIndex = 1; MipIndex < NumMips; MipIndex++)
+    {
+        const int32 MipWidth = FMath::Max(InWidth >> MipIndex, 1);
+        const int32 MipHeight = FMath::Max(InHeight >> MipIndex, 1);
+        const int32 TilesX = FMath::DivideAndRoundUp(MipWidth, UploadTileSize);
+        const int32 TilesY = FMath::DivideAndRoundUp(MipHeight, UploadTileSize);
+
+        TArray<bool> MipTileDirty;
+        MipTileDirty.Init(false, TilesX * TilesY);
+        for (const FSurvivalTerrainTile& ParentRegion : Chain->DirtyRegions[MipIndex - 1])
+        {
+            const int32 MinX = FMath::Min(ParentRegion.MinX / 2, MipWidth - 1);
+            const int32 MinY = FMath::Min(ParentRegion.MinY / 2, MipHeight - 1);
+            const int32 MaxX = FMath::Clamp((ParentRegion.MaxX + 1) / 2, MinX + 1, MipWidth);
+            const int32 MaxY = FMath::Clamp((ParentRegion.MaxY + 1) / 2, MinY + 1, MipHeight);
+            for (int32 TileY = MinY / UploadTileSize; TileY <= (MaxY - 1) / UploadTileSize; TileY++)
+            {
+                for (int32 TileX = MinX / UploadTileSize; TileX <= (MaxX - 1) / UploadTileSize; TileX++)
+                {
+                    MipTileDirty[TileY * TilesX + TileX] = true;
+                }
+            }
+        }
+
+        TArray<FSurvivalTerrainTile>& MipRegions = Chain->DirtyRegions[MipIndex];
+        for (int32 TileY = 0; TileY < TilesY; TileY++)
+        {
+            for (int32 TileX = 0; TileX < TilesX; TileX++)
+            {
+                if (MipTileDirty[TileY * TilesX + TileX])
+                {
+                    MipRegions.Emplace(TileX * UploadTileSize, TileY * UploadTileSize,
+                                       FMath::Min((TileX + 1) * UploadTileSize, MipWidth), FMath::Min((TileY + 1) * UploadTileSize, MipHeight));
+                }
+            }
+        }
+
+        FSurvivalTerrainTiling::ParallelForEachTile(MipRegions, [&Chain, MipIndex](const FSurvivalTerrainTile& Tile)
+        {
+            Chain->BuildMipTile(MipIndex, Tile);
+        });
+    }
+
+    return Chain;
+}
+
+void FSurvivalWeightmapMipChain::BuildMipTile(int32 MipIndex, const FSurvivalTerrainTile& Tile)
+{
+    const int32 ParentWidth = FMath::Max(Width >> (MipIndex - 1), 1);
+    const int32 ParentHeight = FMath::Max(Height >> (MipIndex - 1), 1);
+    const int32 MipWidth = FMath::Max(Width >> MipIndex, 1);
+    const FColor* Parent = Mips[MipIndex - 1].GetData();
+    FColor* Mip = Mips[MipIndex].GetData();
+
+    // 2x2 box filter; on odd parent sizes the last row and column are dropped, as the GPU would
+    for (int32 Y = Tile.MinY; Y < Tile.MaxY; Y++)
+    {
+        const FColor* Row0 = Parent + FMath::Min(Y * 2, ParentHeight - 1) * ParentWidth;
+        const FColor* Row1 = Parent + FMath::Min(Y * 2 + 1, ParentHeight - 1) * ParentWidth;
+
+        for (int32 X = Tile.MinX; X < Tile.MaxX; X++)
+        {
+            const int32 X0 = FMath::Min(X * 2, ParentWidth - 1);
+            const int32 X1 = FMath::Min(X * 2 + 1, ParentWidth - 1);
+
+            // Rounded average per channel
+            FColor& Out = Mip[Y * MipWidth + X];
+            Out.R = uint8((Row0[X0].R + Row0[X1].R + Row1[X0].R + Row1[X1].R + 2) / 4);
+            Out.G = uint8((Row0[X0].G + Row0[X1].G + Row1[X0].G + Row1[X1].G + 2) / 4);
+            Out.B = uint8((Row0[X0].B + Row0[X1].B + Row1[X0].B + Row1[X1].B + 2) / 4);
+            Out.A = uint8((Row0[X0].A + Row0[X1].A + Row1[X0].A + Row1[X1].A + 2) / 4);
+        }
+    }
+}
+
+UTexture2D* FSurvivalWeightmapTexture::CreateOrReuse(UTexture2D* Texture, UObject* Outer, const FSurvivalWeightmapMipChain& Chain)
+{
+    const int32 NumMips = Chain.Mips.Num();
+    if (Texture && Texture->GetSizeX() == Chain.Width && Texture->GetSizeY() == Chain.Height
+        && Texture->GetPixelFormat() == PF_B8G8R8A8 && Texture->GetNumMips() == NumMips)
+    {
+        return Texture;
+    }
+
+    if (Texture)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Weightmap texture %s doesn't match the %dx%d B8G8R8A8 weightmap with %d mips; using a transient texture"),
+               *Texture->GetName(), Chain.Width, Chain.Height, NumMips);
+    }
+
+    UTexture2D* NewTexture = UTexture2D::CreateTransient(Chain.Width, Chain.Height, PF_B8G8R8A8, MakeUniqueObjectName(Outer, UTexture2D::StaticClass(), TEXT("BiomeWeightmap")));
+    if (!NewTexture)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Could not create a %dx%d weightmap texture"), Chain.Width, Chain.Height);
+        return nullptr;
+    }
+
+    // Weights are data, not color; every mip stays resident so any region can be updated in place
+    NewTexture->SRGB = false;
+    NewTexture->CompressionSettings = TC_VectorDisplacementmap;
+    NewTexture->NeverStream = true;
+    NewTexture->AddressX = TA_Clamp;
+    NewTexture->AddressY = TA_Clamp;
+
+    FTexturePlatformData* PlatformData = NewTexture->GetPlatformData();
+    for (int32 MipIndex = 0; MipIndex < NumMips; MipIndex++)
+    {
+        if (MipIndex > 0)
+        {
+            PlatformData->Mips.Add(new FTexture2DMipMap(FMath::Max(Chain.Width >> MipIndex, 1), FMath::Max(Chain.Height >> MipIndex, 1)));
+        }
+
+        // Initial contents come from the CPU chain; UpdateTextureRegions takes over from here
+        FTexture2DMipMap& Mip = PlatformData->Mips[MipIndex];
+        const TArray<FColor>& Source = Chain.Mips[MipIndex];
+        Mip.BulkData.Lock(LOCK_READ_WRITE);
+        void* MipData = Mip.BulkData.Realloc(Source.Num() * sizeof(FColor));
+        FMemory::Memcpy(MipData, Source.GetData(), Source.Num() * sizeof(FColor));
+        Mip.BulkData.Unlock();
+    }
+
+    NewTexture->UpdateResource();
+    return NewTexture;
+}
+
+void FSurvivalWeightmapTexture::UploadDirtyRegions(UTexture2D* Texture, const TSharedRef<const FSurvivalWeightmapMipChain>& Chain)
+{
+    check(IsInGameThread());
+
+    if (!Texture || !FApp::CanEverRender() || !Texture->GetResource())
+    {
+        return;
+    }
+
+    for (int32 MipIndex = 0; MipIndex < Chain->Mips.Num(); MipIndex++)
+    {
+        const TArray<FSurvivalTerrainTile>& MipRegions = Chain->DirtyRegions[MipIndex];
+        if (MipRegions.Num() == 0)
+        {
+            continue;
+        }
+
+        // Freed by the cleanup callback once the render thread has copied them
+        FUpdateTextureRegion2D* Regions = new FUpdateTextureRegion2D[MipRegions.Num()];
+        for (int32 RegionIndex = 0; RegionIndex < MipRegions.Num(); RegionIndex++)
+        {
+            const FSurvivalTerrainTile& Tile = MipRegions[RegionIndex];
+            Regions[RegionIndex] = FUpdateTextureRegion2D(Tile.MinX, Tile.MinY, Tile.MinX, Tile.MinY, Tile.GetWidth(), Tile.GetHeight());
+        }
+
+        const int32 MipWidth = FMath::Max(Chain->Width >> MipIndex, 1);
+        uint8* SourceData = reinterpret_cast<uint8*>(const_cast<FColor*>(Chain->Mips[MipIndex].GetData()));
+        Texture->UpdateTextureRegions(MipIndex, MipRegions.Num(), Regions, MipWidth * sizeof(FColor), sizeof(FColor), SourceData,
+            [Chain](uint8* /*SrcData*/, const FUpdateTextureRegion2D* InRegions)
+            {
+                delete[] InRegions;
+            });
+    }
+}
\ No newline at end of file
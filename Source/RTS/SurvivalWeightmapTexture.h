@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SurvivalTerrainTiling.h"
+
+class UTexture2D;
+
+// CPU copy of a packed weightmap (one FColor per texel) and its box-filtered mip chain. Immutable once
+// built, so the render thread can upload from one chain while the next is built on a worker thread.
+struct RTS_API FSurvivalWeightmapMipChain
+{
+    // Granularity of change detection and of the regions handed to UpdateTextureRegions
+    static constexpr int32 UploadTileSize = 64;
+
+    int32 Width;
+    int32 Height;
+    TArray<TArray<FColor>> Mips;
+
+    // Texels of each mip that differ from the chain this one was built from
+    TArray<TArray<FSurvivalTerrainTile>> DirtyRegions;
+
+    FSurvivalWeightmapMipChain();
+
+    static int32 GetNumMips(int32 Width, int32 Height);
+
+    // Chain for Texels. Starts from Previous when it has the same size and only rebuilds the mip texels above
+    // tiles whose contents changed; without a compatible Previous everything is built and dirty.
+    static TSharedRef<FSurvivalWeightmapMipChain> Build(const FSurvivalWeightmapMipChain* Previous, TArray<FColor>&& Texels, int32 Width, int32 Height);
+
+    bool HasDirtyRegions() const;
+
+private:
+    void BuildMipTile(int32 MipIndex, const FSurvivalTerrainTile& Tile);
+};
+
+// Runtime weightmap textures fed from mip chains. Uploads are queued with UpdateTextureRegions and never wait
+// for the render thread. Without a renderer (-nullrhi) textures are still created but nothing is uploaded.
+struct RTS_API FSurvivalWeightmapTexture
+{
+    // Returns Texture when it matches the chain's size, format and mip count, otherwise a new transient texture
+    static UTexture2D* CreateOrReuse(UTexture2D* Texture, UObject* Outer, const FSurvivalWeightmapMipChain& Chain);
+
+    // Chain is kept alive until the render thread has copied every dirty region
+    static void UploadDirtyRegions(UTexture2D* Texture, const TSharedRef<const FSurvivalWeightmapMipChain>& Chain);
+};
\ No newline at end of file